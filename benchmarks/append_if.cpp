@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Building an inplace_vector<uint32_t, 256> from the entries of a scan that
+// pass a filter: a try_push_back loop, which branches on every entry,
+// against a push_back_if loop and append_if. The filter keeps a random half
+// of the entries, so its outcome cannot be predicted. The compress paths of
+// append_if need a target with AVX-512 or AVX2 and BMI2, e.g.
+// -march=native.
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+using out_t = beman::inplace_vector<std::uint32_t, 256>;
+
+int main() {
+  constexpr std::size_t iterations = 200'000;
+  std::mt19937 rng(42);
+  std::vector<std::uint32_t> scan(256);
+  for (auto &e : scan)
+    e = rng();
+  auto pass = [](std::uint32_t e) { return (e & 1u) != 0; };
+  out_t out;
+  bench::report("try_push_back loop", scan.size(),
+                bench::ns_per_op(iterations, [&] {
+                  out.clear();
+                  for (std::uint32_t e : scan)
+                    if (pass(e))
+                      static_cast<void>(out.try_push_back(e));
+                  bench::do_not_optimize(out);
+                }));
+  bench::report("push_back_if loop", scan.size(),
+                bench::ns_per_op(iterations, [&] {
+                  out.clear();
+                  for (std::uint32_t e : scan)
+                    out.push_back_if(pass(e), e);
+                  bench::do_not_optimize(out);
+                }));
+  bench::report("append_if", scan.size(), bench::ns_per_op(iterations, [&] {
+                  out.clear();
+                  out.append_if(scan, pass);
+                  bench::do_not_optimize(out);
+                }));
+  return 0;
+}
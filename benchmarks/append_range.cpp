@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Draining spans into a fixed inplace_vector<uint32_t, 1024> buffer:
+// try_append_range, which checks the capacity once and copies with one
+// memcpy, against a try_push_back loop, which checks it per element. Each
+// iteration appends a span to an empty buffer; spans longer than the buffer
+// are only partly drained.
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+using buffer = beman::inplace_vector<std::uint32_t, 1024>;
+
+void run(std::size_t size, std::size_t iterations) {
+  std::vector<std::uint32_t> upstream(size);
+  for (std::size_t i = 0; i < size; ++i)
+    upstream[i] = static_cast<std::uint32_t>(i * 2654435761u);
+  std::span<std::uint32_t const> span(upstream);
+  buffer out;
+  bench::report("try_append_range", size, bench::ns_per_op(iterations, [&] {
+                  out.clear();
+                  auto rest = out.try_append_range(span);
+                  bench::do_not_optimize(out);
+                  bench::do_not_optimize(rest);
+                }));
+  bench::report("  try_push_back loop", size,
+                bench::ns_per_op(iterations, [&] {
+                  out.clear();
+                  auto rest = span.begin();
+                  for (; rest != span.end(); ++rest)
+                    if (!out.try_push_back(*rest))
+                      break;
+                  bench::do_not_optimize(out);
+                  bench::do_not_optimize(rest);
+                }));
+}
+
+int main() {
+  constexpr std::size_t iterations = 1'000'000;
+  run(16, iterations);
+  run(256, iterations);
+  run(1024, iterations / 4);
+  run(1500, iterations / 4);
+  return 0;
+}
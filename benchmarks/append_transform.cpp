@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Filling an inplace_vector<float, 256> from a callable: append_transform
+// and append_generate, which check the capacity once and construct in one
+// loop that compilers vectorize, against push_back loops, which keep the
+// capacity check and the size update in the loop body.
+
+#include <cstddef>
+#include <vector>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+using out_t = beman::inplace_vector<float, 256>;
+
+int main() {
+  constexpr std::size_t iterations = 1'000'000;
+  std::vector<float> in(256);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    in[i] = static_cast<float>(i) * 0.25f;
+  auto scale = [](float x) { return x * 2.f + 1.f; };
+  // Through int: converting a size_t to float has no SSE2 vector form.
+  auto ramp = [](std::size_t i) {
+    return static_cast<float>(static_cast<int>(i)) * 0.5f;
+  };
+  out_t out;
+  bench::report("append_transform", in.size(),
+                bench::ns_per_op(iterations, [&] {
+                  out.clear();
+                  out.append_transform(in, scale);
+                  bench::do_not_optimize(out);
+                }));
+  bench::report("  push_back(f(x)) loop", in.size(),
+                bench::ns_per_op(iterations, [&] {
+                  out.clear();
+                  for (float x : in)
+                    out.push_back(scale(x));
+                  bench::do_not_optimize(out);
+                }));
+  bench::report("append_generate", out.capacity(),
+                bench::ns_per_op(iterations, [&] {
+                  out.clear();
+                  out.append_generate(out.capacity(), ramp);
+                  bench::do_not_optimize(out);
+                }));
+  bench::report("  push_back(f(i)) loop", out.capacity(),
+                bench::ns_per_op(iterations, [&] {
+                  out.clear();
+                  for (std::size_t i = 0; i != out.capacity(); ++i)
+                    out.push_back(ramp(i));
+                  bench::do_not_optimize(out);
+                }));
+  return 0;
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+/// Minimal timing helpers shared by the benchmarks. They are intentionally
+/// dependency-free so that the benchmarks build anywhere the tests do.
+namespace bench {
+
+/// Forces the compiler to assume `value` is read and modified, so that the
+/// work producing it cannot be optimized away.
+template <class T> inline void do_not_optimize(T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static_cast<void>(*static_cast<volatile char *>(static_cast<void *>(&value)));
+#endif
+}
+
+/// Average wall-clock time, in nanoseconds, of one call to `f`.
+template <class F> double ns_per_op(std::size_t iterations, F &&f) {
+  using clock = std::chrono::steady_clock;
+  for (std::size_t i = 0; i < iterations / 10 + 1; ++i) // warm-up
+    f();
+  auto const start = clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+    f();
+  auto const stop = clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         static_cast<double>(iterations);
+}
+
+inline void report(char const *name, std::size_t n, double ns) {
+  std::printf("%-48s N=%-6zu %10.2f ns/op\n", name, n, ns);
+}
+
+} // namespace bench
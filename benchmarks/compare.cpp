@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// operator== and operator<=> on byte vectors, e.g. hash-map keys, against
+// the element loops they replaced. The vectors are equal but for their last
+// element, so every comparison reads them whole.
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+template <class V> bool loop_equal(V const &a, V const &b) {
+  return a.size() == b.size() && std::ranges::equal(a, b);
+}
+
+template <class V> std::strong_ordering loop_compare(V const &a, V const &b) {
+  std::size_t const n = std::min(a.size(), b.size());
+  for (std::size_t i = 0; i < n; ++i)
+    if (a[i] != b[i])
+      return a[i] <=> b[i];
+  return a.size() <=> b.size();
+}
+
+template <std::size_t N> void run(std::size_t size, std::size_t iterations) {
+  using bytes = beman::inplace_vector<std::uint8_t, N>;
+  bytes a, b;
+  for (std::size_t i = 0; i < size; ++i) {
+    a.push_back(static_cast<std::uint8_t>(i));
+    b.push_back(static_cast<std::uint8_t>(i));
+  }
+  if (size != 0)
+    b.back() = 0xff;
+  bool eq = false;
+  std::strong_ordering ord = std::strong_ordering::equal;
+  bench::report("operator== uint8_t", size, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(a);
+                  eq = a == b;
+                  bench::do_not_optimize(eq);
+                }));
+  bench::report("  element loop", size, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(a);
+                  eq = loop_equal(a, b);
+                  bench::do_not_optimize(eq);
+                }));
+  bench::report("operator<=> uint8_t", size, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(a);
+                  ord = a <=> b;
+                  bench::do_not_optimize(ord);
+                }));
+  bench::report("  element loop", size, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(a);
+                  ord = loop_compare(a, b);
+                  bench::do_not_optimize(ord);
+                }));
+}
+
+int main() {
+  constexpr std::size_t iterations = 1'000'000;
+  run<32>(4, iterations);
+  run<32>(16, iterations);
+  run<32>(32, iterations);
+  run<256>(256, iterations / 4);
+  return 0;
+}
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Cost of default-constructing an empty inplace_vector of trivial elements.
+// The storage is left uninitialized at run-time, so the cost should be flat
+// in N; the value-initialized std::array shows what zero-filling costs.
+
+#include <array>
+#include <cstddef>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+template <std::size_t N> void run(std::size_t iterations) {
+  bench::report("inplace_vector<int, N>{}", N,
+                bench::ns_per_op(iterations, [] {
+                  beman::inplace_vector<int, N> v;
+                  bench::do_not_optimize(v);
+                }));
+  bench::report("inplace_vector<int, N>{}.push_back(1)", N,
+                bench::ns_per_op(iterations, [] {
+                  beman::inplace_vector<int, N> v;
+                  v.push_back(1);
+                  bench::do_not_optimize(v);
+                }));
+  bench::report("std::array<int, N>{} (zero-filled)", N,
+                bench::ns_per_op(iterations, [] {
+                  std::array<int, N> a{};
+                  bench::do_not_optimize(a);
+                }));
+}
+
+int main() {
+  constexpr std::size_t iterations = 1'000'000;
+  run<16>(iterations);
+  run<256>(iterations);
+  run<4096>(iterations);
+  run<16384>(iterations);
+  return 0;
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// erase_if on inplace_vector<uint32_t, 1024>, which packs the surviving
+// elements without branching on the predicate, against the remove_if and
+// erase idiom. A share of random entries is dead; each iteration filters a
+// fresh copy, and the copy is part of both timings. The compress paths need
+// a target with AVX-512 or AVX2 and BMI2, e.g. -march=native.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+using entries = beman::inplace_vector<std::uint32_t, 1024>;
+
+void run(char const *name, unsigned dead_percent, std::size_t iterations) {
+  std::mt19937 rng(42);
+  static entries in;
+  in.clear();
+  for (std::size_t i = 0; i < in.capacity(); ++i)
+    in.push_back(rng() % 100 < dead_percent ? 0u : rng() | 1u);
+  auto dead = [](std::uint32_t e) { return e == 0; };
+  static entries v;
+  bench::report(name, in.size(), bench::ns_per_op(iterations, [&] {
+                  v = in;
+                  erase_if(v, dead);
+                  bench::do_not_optimize(v);
+                }));
+  bench::report("  remove_if + erase", in.size(),
+                bench::ns_per_op(iterations, [&] {
+                  v = in;
+                  v.erase(std::remove_if(v.begin(), v.end(), dead), v.end());
+                  bench::do_not_optimize(v);
+                }));
+}
+
+int main() {
+  constexpr std::size_t iterations = 200'000;
+  run("erase_if uint32_t, 10% dead", 10, iterations);
+  run("erase_if uint32_t, 50% dead", 50, iterations);
+  run("erase_if uint32_t, 90% dead", 90, iterations);
+  return 0;
+}
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// std::hash of inplace_vector<uint32_t, 16> keys, which hashes the elements'
+// bytes in one pass, against combining the element hashes one by one.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+using key = beman::inplace_vector<std::uint32_t, 16>;
+
+std::size_t hash_combine(key const &k) {
+  std::size_t seed = k.size();
+  for (std::uint32_t e : k)
+    seed ^= std::hash<std::uint32_t>{}(e) + 0x9e3779b97f4a7c15ull +
+            (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+void run(std::size_t size, std::size_t iterations) {
+  key k;
+  for (std::size_t i = 0; i < size; ++i)
+    k.push_back(static_cast<std::uint32_t>(i * 2654435761u));
+  std::size_t h = 0;
+  bench::report("std::hash<inplace_vector<uint32_t, 16>>", size,
+                bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(k);
+                  h = std::hash<key>{}(k);
+                  bench::do_not_optimize(h);
+                }));
+  bench::report("  hash_combine", size, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(k);
+                  h = hash_combine(k);
+                  bench::do_not_optimize(h);
+                }));
+}
+
+int main() {
+  constexpr std::size_t iterations = 1'000'000;
+  run(4, iterations);
+  run(8, iterations);
+  run(16, iterations);
+  return 0;
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// inplace_vector::radix_sort, which needs no heap memory, against std::sort
+// on batches of timestamps. Each iteration sorts a fresh copy of the batch;
+// the copy is part of both timings.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+template <class T, std::size_t N>
+void run(char const *name, std::size_t size, std::size_t iterations) {
+  using V = beman::inplace_vector<T, N>;
+  std::mt19937_64 rng(42);
+  static V in;
+  in.clear();
+  // Timestamps a few seconds apart, in nanoseconds, arriving out of order.
+  for (std::size_t i = 0; i < size; ++i)
+    in.push_back(static_cast<T>(1'700'000'000'000'000'000ull + i * 1'000'000 +
+                                rng() % 50'000'000));
+  static V v;
+  bench::report(name, size, bench::ns_per_op(iterations, [&] {
+                  v = in;
+                  v.radix_sort();
+                  bench::do_not_optimize(v);
+                }));
+  bench::report("  std::sort", size, bench::ns_per_op(iterations, [&] {
+                  v = in;
+                  std::sort(v.begin(), v.end());
+                  bench::do_not_optimize(v);
+                }));
+}
+
+int main() {
+  constexpr std::size_t iterations = 2'000;
+  run<std::uint64_t, 4096>("radix_sort uint64_t", 256, iterations * 8);
+  run<std::uint64_t, 4096>("radix_sort uint64_t", 1024, iterations * 2);
+  run<std::uint64_t, 4096>("radix_sort uint64_t", 4096, iterations);
+  run<double, 4096>("radix_sort double", 4096, iterations);
+  return 0;
+}
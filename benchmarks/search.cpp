@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// inplace_vector's find, count, sum and minmax members, which work in
+// fixed-width blocks, against the std::ranges algorithms. The vectors are
+// full and the value searched for is absent, so every search reads them
+// whole.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+template <class T, std::size_t N> void run(std::size_t iterations) {
+  beman::inplace_vector<T, N> v;
+  for (std::size_t i = 0; i < N; ++i)
+    v.push_back(static_cast<T>(i % 100));
+  T const absent = static_cast<T>(-1);
+  std::size_t r = 0;
+  T t{};
+  bench::report("find", N, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(v);
+                  r = static_cast<std::size_t>(v.find(absent) - v.begin());
+                  bench::do_not_optimize(r);
+                }));
+  bench::report("  std::ranges::find", N, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(v);
+                  r = static_cast<std::size_t>(std::ranges::find(v, absent) -
+                                               v.begin());
+                  bench::do_not_optimize(r);
+                }));
+  bench::report("count", N, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(v);
+                  r = v.count(absent);
+                  bench::do_not_optimize(r);
+                }));
+  bench::report("  std::ranges::count", N, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(v);
+                  r = static_cast<std::size_t>(std::ranges::count(v, absent));
+                  bench::do_not_optimize(r);
+                }));
+  bench::report("sum", N, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(v);
+                  t = v.sum();
+                  bench::do_not_optimize(t);
+                }));
+  bench::report("  std::accumulate", N, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(v);
+                  t = std::accumulate(v.begin(), v.end(), T{});
+                  bench::do_not_optimize(t);
+                }));
+  bench::report("minmax", N, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(v);
+                  t = v.minmax().max;
+                  bench::do_not_optimize(t);
+                }));
+  bench::report("  std::ranges::minmax", N, bench::ns_per_op(iterations, [&] {
+                  bench::do_not_optimize(v);
+                  t = std::ranges::minmax(v).max;
+                  bench::do_not_optimize(t);
+                }));
+}
+
+int main() {
+  constexpr std::size_t iterations = 1'000'000;
+  std::printf("int32_t\n");
+  run<std::int32_t, 8>(iterations);
+  run<std::int32_t, 16>(iterations);
+  run<std::int32_t, 64>(iterations);
+  run<std::int32_t, 256>(iterations);
+  std::printf("float\n");
+  run<float, 8>(iterations);
+  run<float, 16>(iterations);
+  run<float, 64>(iterations);
+  run<float, 256>(iterations);
+  return 0;
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// inplace_vector::sort, which uses a sorting network for small integer
+// vectors and insertion sort for other small ones, against std::sort. Each
+// iteration sorts a fresh copy of one of many random inputs, too many for
+// the branch predictor to learn; the copy is part of both timings.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC 12 reports false -Warray-bounds positives in std::sort's heapsort
+// fallback when it sorts a small fixed-size object.
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+
+template <class T, std::size_t N>
+void run(char const *name, std::size_t iterations) {
+  using V = beman::inplace_vector<T, N>;
+  constexpr std::size_t inputs = 4096;
+  std::mt19937 rng(42);
+  static V in[inputs];
+  for (V &v : in)
+    for (std::size_t i = 0; i < N; ++i)
+      v.push_back(static_cast<T>(rng() % 1000));
+  std::size_t k = 0;
+  bench::report(name, N, bench::ns_per_op(iterations, [&] {
+                  V v = in[k++ % inputs];
+                  v.sort();
+                  bench::do_not_optimize(v);
+                }));
+  bench::report("  std::sort", N, bench::ns_per_op(iterations, [&] {
+                  V v = in[k++ % inputs];
+                  std::sort(v.begin(), v.end());
+                  bench::do_not_optimize(v);
+                }));
+}
+
+int main() {
+  constexpr std::size_t iterations = 1'000'000;
+  run<std::uint32_t, 8>("sort inplace_vector<uint32_t, N>", iterations);
+  run<std::uint32_t, 16>("sort inplace_vector<uint32_t, N>", iterations);
+  run<std::uint32_t, 32>("sort inplace_vector<uint32_t, N>", iterations);
+  run<float, 16>("sort inplace_vector<float, N>", iterations);
+  run<double, 32>("sort inplace_vector<double, N>", iterations);
+  return 0;
+}
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// inplace_vector::swap against the three-move swap it replaced, which
+// needed a temporary as large as the whole vector.
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+template <class V> void three_move_swap(V &a, V &b) {
+  V tmp = std::move(a);
+  a = std::move(b);
+  b = std::move(tmp);
+}
+
+template <class T, std::size_t N>
+void run(char const *name, T const &value, std::size_t iterations) {
+  beman::inplace_vector<T, N> a(N / 2, value);
+  beman::inplace_vector<T, N> b(N / 4, value);
+  bench::report(name, N, bench::ns_per_op(iterations, [&] {
+                  a.swap(b);
+                  bench::do_not_optimize(a);
+                }));
+  bench::report("  three-move swap", N, bench::ns_per_op(iterations, [&] {
+                  three_move_swap(a, b);
+                  bench::do_not_optimize(a);
+                }));
+}
+
+int main() {
+  constexpr std::size_t iterations = 100'000;
+  run<int, 64>("swap inplace_vector<int, N>", 1, iterations);
+  run<int, 4096>("swap inplace_vector<int, N>", 1, iterations);
+  std::string const s = "a string too long for the small string buffer";
+  run<std::string, 64>("swap inplace_vector<std::string, N>", s, iterations);
+  run<std::string, 1024>("swap inplace_vector<std::string, N>", s,
+                         iterations / 10);
+  return 0;
+}
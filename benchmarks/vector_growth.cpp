@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Growth of a std::vector of inplace_vectors. inplace_vector's move
+// constructor is noexcept when the element's is, so std::vector moves the
+// elements on reallocation; the wrapper with a potentially-throwing move
+// shows the cost of the copies std::vector falls back to otherwise.
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <beman/inplace_vector/inplace_vector.hpp>
+
+#include "bench.hpp"
+
+struct order {
+  std::string symbol = "a symbol too long for the small string buffer";
+  double price = 0;
+};
+
+using orders = beman::inplace_vector<order, 16>;
+
+// Same element storage, but a move constructor that may throw.
+struct throwing_move_orders {
+  orders v;
+  throwing_move_orders() = default;
+  throwing_move_orders(throwing_move_orders const &) = default;
+  throwing_move_orders(throwing_move_orders &&o) noexcept(false)
+      : v(std::move(o.v)) {}
+};
+
+template <class V> double grow(std::size_t count, std::size_t iterations) {
+  V prototype;
+  for (std::size_t i = 0; i < 8; ++i) {
+    if constexpr (requires { prototype.v; })
+      prototype.v.emplace_back();
+    else
+      prototype.emplace_back();
+  }
+  return bench::ns_per_op(iterations, [&] {
+    std::vector<V> vs;
+    for (std::size_t i = 0; i < count; ++i)
+      vs.push_back(prototype);
+    bench::do_not_optimize(vs);
+  });
+}
+
+int main() {
+  constexpr std::size_t iterations = 200;
+  for (std::size_t count : {16, 256, 4096}) {
+    bench::report("std::vector<inplace_vector<order, 16>> growth", count,
+                  grow<orders>(count, iterations));
+    bench::report("std::vector<throwing-move wrapper> growth", count,
+                  grow<throwing_move_orders>(count, iterations));
+  }
+  return 0;
+}
@@ -254,18 +254,27 @@ Software.
  */
 #include <algorithm> // for rotate, equals, move_backwards, ...
 #include <array>
+#include <bit>        // for bit_ceil
+#include <compare>    // for strong_ordering and weak_ordering
 #include <concepts>   // for lots...
 #include <cstddef>    // for size_t
 #include <cstdint>    // for fixed-width integer types
-#include <functional> // for less and equal_to
+#include <cstring>    // for memmove and memcmp
+#include <functional> // for less, equal_to and hash
 #include <iterator>   // for reverse_iterator and iterator traits
 #include <limits>     // for numeric_limits
+#include <memory>     // for construct_at and destroy
 #include <new>        // for operator new
 #include <ranges>
 #include <stdexcept>   // for length_error
 #include <stdio.h>     // for assertion diagnostics
+#include <string_view> // for hashing bytes
 #include <type_traits> // for aligned_storage and all meta-functions
 
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__BMI2__))
+#include <immintrin.h> // for the compress paths of erase and erase_if
+#endif
+
 // Optimizer allowed to assume that EXPR evaluates to true
 #define __IV_ASSUME(__EXPR)                                                    \
   static_cast<void>((__EXPR) ? void(0) : __builtin_unreachable)
@@ -303,8 +312,83 @@ inline constexpr from_range_t from_range;
 namespace beman {
 struct from_range_t {};
 inline constexpr from_range_t from_range;
+
+/// Customization point: whether move-constructing a __T and then destroying
+/// the source is equivalent to copying its bytes. True for trivially copyable
+/// types; specialize it to `true` to opt other types in, e.g. types that only
+/// hold a `std::unique_ptr`. inplace_vector then relocates such elements with
+/// memmove when erasing, inserting, swapping and moving.
+template <class __T>
+inline constexpr bool enable_trivially_relocatable =
+    ::std::is_trivially_copyable_v<__T>;
 }; // namespace beman
 
+/// Options controlling the layout of an inplace_vector's storage, passed as
+/// its third template argument, e.g.
+/// `inplace_vector<int, 1024, iv_layout::size_first>`.
+///
+/// By default the size is stored after the elements. The storage is not a
+/// POD, so on the Itanium C++ ABI an enclosing struct can place members in
+/// the padding that follows the size by declaring the inplace_vector
+/// `[[no_unique_address]]`.
+namespace beman::iv_layout {
+
+/// Combines several options into one layout, e.g. `options<size_first>`.
+template <class... __Options> struct options : __Options... {};
+
+/// Stores the size before the elements, so that for large vectors it shares a
+/// cache line with the first elements instead of the last ones.
+struct size_first {
+  static constexpr bool __size_first = true;
+};
+
+/// Stores the size as a __Size instead of the smallest unsigned integer type
+/// that can represent the capacity, e.g. to give vectors of different
+/// capacities the same layout. __Size must be able to represent the capacity.
+template <class __Size> struct stored_size {
+  static_assert(::std::is_unsigned_v<__Size>,
+                "stored_size<Size> requires an unsigned integer type");
+  using __stored_size_type = __Size;
+};
+
+/// Aligns the element storage to at least __Align bytes, e.g. `align<64>` to
+/// start it on a cache line, for aligned SIMD loads or for per-thread buffers
+/// that must not share a cache line. The vector's alignment, and so its size,
+/// grow accordingly.
+template <::std::size_t __Align> struct align {
+  static_assert(__Align != 0 && (__Align & (__Align - 1)) == 0,
+                "align<A> requires a power of two");
+  static constexpr ::std::size_t __align = __Align;
+};
+
+/// Rounds the element storage up to a multiple of __Bytes, e.g. a SIMD
+/// register width, and keeps every slot past size() value-initialized (zero
+/// for arithmetic types). Kernels can then process data() in whole registers
+/// up to padded_capacity() without a scalar tail loop. Combine with
+/// `align<__Bytes>` for aligned loads.
+///
+/// Requires a trivial element type whose size divides __Bytes. The storage is
+/// zero-filled on construction, and slots vacated by shrinking are refilled.
+template <::std::size_t __Bytes> struct pad_to {
+  static_assert(__Bytes != 0 && (__Bytes & (__Bytes - 1)) == 0,
+                "pad_to<B> requires a power of two");
+  static constexpr ::std::size_t __pad_to = __Bytes;
+};
+
+/// Stores no size: every slot past size() holds __Value, and the size is the
+/// number of slots that do not, e.g. `sentinel<nullptr>` for pointers that
+/// are never null. Then `sizeof(inplace_vector<T*, 4, sentinel<nullptr>>)`
+/// is `4 * sizeof(T*)`.
+///
+/// Requires a trivial element type comparable with __Value; the elements
+/// must never equal __Value. size() counts over all capacity() slots, so this
+/// suits small capacities.
+template <auto __Value> struct sentinel {
+  static constexpr auto __sentinel = __Value;
+};
+
+} // namespace beman::iv_layout
+
 // Private utilities
 namespace beman::__iv_detail {
 
@@ -327,10 +411,10 @@ using namespace beman::__iv_detail;
 // Smallest unsigned integer that can represent values in [0, N].
 template <size_t __N>
 using __smallest_size_t
-= conditional_t<(__N < numeric_limits<uint8_t>::max()),  uint8_t,
-    conditional_t<(__N < numeric_limits<uint16_t>::max()), uint16_t,
-    conditional_t<(__N < numeric_limits<uint32_t>::max()), uint32_t,
-    conditional_t<(__N < numeric_limits<uint64_t>::max()), uint64_t,
+= conditional_t<(__N <= numeric_limits<uint8_t>::max()),  uint8_t,
+    conditional_t<(__N <= numeric_limits<uint16_t>::max()), uint16_t,
+    conditional_t<(__N <= numeric_limits<uint32_t>::max()), uint32_t,
+    conditional_t<(__N <= numeric_limits<uint64_t>::max()), uint64_t,
                    size_t>>>>;
 // clang-format on
 
@@ -354,6 +438,465 @@ concept __move_or_copy_insertable_from = requires(__Ptr __ptr, __T &&__value) {
   { construct_at(__ptr, ::std::forward<__T &&>(__value)) } -> same_as<__Ptr>;
 };
 
+template <class __T>
+concept __trivially_relocatable =
+    !is_volatile_v<__T> && enable_trivially_relocatable<remove_const_t<__T>>;
+
+// Moves the objects in [__first, __last) to __dest, which may overlap, by
+// copying their bytes. Afterwards the objects live at __dest only: the
+// source must be neither destroyed nor used. Run-time only.
+template <__trivially_relocatable __T>
+void __relocate(__T *__first, __T *__last, __T *__dest) noexcept {
+  if (__first != __last)
+    memmove(static_cast<void *>(__dest), static_cast<const void *>(__first),
+            static_cast<size_t>(__last - __first) * sizeof(__T));
+}
+
+// Exchanges the __n bytes at __a and __b, which must not overlap, through a
+// small fixed-size buffer. Run-time only.
+inline void __swap_bytes(void *__a, void *__b, size_t __n) noexcept {
+  constexpr size_t __chunk = 64;
+  auto *__x = static_cast<unsigned char *>(__a);
+  auto *__y = static_cast<unsigned char *>(__b);
+  unsigned char __tmp[__chunk];
+  for (; __n >= __chunk; __n -= __chunk, __x += __chunk, __y += __chunk) {
+    memcpy(__tmp, __x, __chunk);
+    memcpy(__x, __y, __chunk);
+    memcpy(__y, __tmp, __chunk);
+  }
+  if (__n != 0) {
+    memcpy(__tmp, __x, __n);
+    memcpy(__x, __y, __n);
+    memcpy(__y, __tmp, __n);
+  }
+}
+
+// Assigns __src to the element __dst, through a temporary if __T is only
+// constructible from it.
+template <class __T, class __U>
+constexpr void __assign_from(__T &__dst, __U &&__src) {
+  if constexpr (assignable_from<__T &, __U &&>)
+    __dst = ::std::forward<__U>(__src);
+  else
+    __dst = __T(::std::forward<__U>(__src));
+}
+
+// Elements whose == compares their bytes: scalars whose every value has a
+// single object representation, which excludes floating-point types.
+template <class __T>
+concept __bitwise_equality_comparable =
+    is_scalar_v<__T> && has_unique_object_representations_v<__T>;
+
+// Elements ordered like the unsigned bytes that memcmp compares.
+template <class __T>
+concept __bytewise_orderable =
+    same_as<remove_cv_t<__T>, unsigned char> ||
+    same_as<remove_cv_t<__T>, char8_t> || same_as<remove_cv_t<__T>, byte> ||
+    (same_as<remove_cv_t<__T>, char> && !is_signed_v<char>);
+
+// http://eel.is/c++draft/expos.only.entity#itemdecl:2
+struct __synth_three_way_fn {
+  template <class __T, class __U>
+  constexpr auto operator()(const __T &__t, const __U &__u) const
+    requires requires {
+      { __t < __u } -> convertible_to<bool>;
+      { __u < __t } -> convertible_to<bool>;
+    }
+  {
+    if constexpr (three_way_comparable_with<__T, __U>) {
+      return __t <=> __u;
+    } else {
+      if (__t < __u)
+        return weak_ordering::less;
+      if (__u < __t)
+        return weak_ordering::greater;
+      return weak_ordering::equivalent;
+    }
+  }
+};
+inline constexpr __synth_three_way_fn __synth_three_way{};
+
+// Search and reduction kernels over the __n <= __Cap elements at __p, for
+// arithmetic elements. Unless the capacity is too small for it to pay off,
+// they work in fixed-width blocks with independent lanes and no early exits
+// inside a block, which compilers vectorize, and finish the tail scalarly.
+// They are plain loops, so the same code runs during constant evaluation.
+//
+// The reductions keep one lane per element of a 32-byte vector register.
+template <class __T>
+inline constexpr size_t __block_width =
+    sizeof(__T) >= 32 ? size_t{1} : 32 / sizeof(__T);
+
+template <class __T, size_t __Cap, size_t __W = __block_width<__T>>
+inline constexpr bool __use_blocks = __Cap >= 2 * __W;
+
+// The search tests whole blocks of this many elements: enough that compilers
+// vectorize the block loop instead of unrolling it into scalar compares.
+inline constexpr size_t __search_block = 32;
+
+// Index of the first element equal to __v, or __n.
+template <size_t __Cap, class __T>
+constexpr size_t __find_index(const __T *__p, size_t __n, __T __v) noexcept {
+  constexpr size_t __w = __search_block;
+  size_t __i = 0;
+  if constexpr (__use_blocks<__T, __Cap, __w>) {
+    for (; __i + __w <= __n; __i += __w) {
+      unsigned __hit = 0;
+      for (size_t __j = 0; __j != __w; ++__j)
+        __hit |= static_cast<unsigned>(__p[__i + __j] == __v);
+      if (__hit != 0)
+        break;
+    }
+  }
+  for (; __i != __n; ++__i)
+    if (__p[__i] == __v)
+      return __i;
+  return __n;
+}
+
+template <size_t __Cap, class __T>
+constexpr size_t __count(const __T *__p, size_t __n, __T __v) noexcept {
+  size_t __c = 0;
+  for (size_t __i = 0; __i != __n; ++__i)
+    __c += static_cast<size_t>(__p[__i] == __v);
+  return __c;
+}
+
+// Sums in __block_width interleaved lanes; for floating-point elements the
+// rounding can therefore differ from a left-to-right sum.
+template <size_t __Cap, class __T>
+constexpr __T __sum(const __T *__p, size_t __n) noexcept {
+  if constexpr (!__use_blocks<__T, __Cap>) {
+    __T __s = 0;
+    for (size_t __i = 0; __i != __n; ++__i)
+      __s += __p[__i];
+    return __s;
+  } else {
+    constexpr size_t __w = __block_width<__T>;
+    __T __lanes[__w] = {};
+    size_t __i = 0;
+    for (; __i + __w <= __n; __i += __w)
+      for (size_t __j = 0; __j != __w; ++__j)
+        __lanes[__j] += __p[__i + __j];
+    for (size_t __j = 0; __i != __n; ++__i, ++__j)
+      __lanes[__j] += __p[__i];
+    __T __s = 0;
+    for (__T __l : __lanes)
+      __s += __l;
+    return __s;
+  }
+}
+
+// The smallest and largest of a non-empty range; which of several equal
+// values, e.g. 0.0 and -0.0, is unspecified, as is the result with NaNs.
+template <size_t __Cap, class __T>
+constexpr ranges::min_max_result<__T> __minmax(const __T *__p,
+                                               size_t __n) noexcept {
+  if constexpr (!__use_blocks<__T, __Cap>) {
+    ranges::min_max_result<__T> __r = {__p[0], __p[0]};
+    for (size_t __i = 1; __i != __n; ++__i) {
+      __r.min = __p[__i] < __r.min ? __p[__i] : __r.min;
+      __r.max = __r.max < __p[__i] ? __p[__i] : __r.max;
+    }
+    return __r;
+  }
+  constexpr size_t __w = __block_width<__T>;
+  __T __lo[__w], __hi[__w];
+  for (size_t __j = 0; __j != __w; ++__j)
+    __lo[__j] = __hi[__j] = __p[0];
+  size_t __i = 0;
+  for (; __i + __w <= __n; __i += __w) {
+    for (size_t __j = 0; __j != __w; ++__j) {
+      const __T __x = __p[__i + __j];
+      __lo[__j] = __x < __lo[__j] ? __x : __lo[__j];
+      __hi[__j] = __hi[__j] < __x ? __x : __hi[__j];
+    }
+  }
+  for (size_t __j = 0; __i != __n; ++__i, ++__j) {
+    __lo[__j] = __p[__i] < __lo[__j] ? __p[__i] : __lo[__j];
+    __hi[__j] = __hi[__j] < __p[__i] ? __p[__i] : __hi[__j];
+  }
+  ranges::min_max_result<__T> __r = {__lo[0], __hi[0]};
+  for (size_t __j = 1; __j != __w; ++__j) {
+    __r.min = __lo[__j] < __r.min ? __lo[__j] : __r.min;
+    __r.max = __r.max < __hi[__j] ? __hi[__j] : __r.max;
+  }
+  return __r;
+}
+
+// Copies the elements among the __n <= __Cap at __src for which __keep
+// returns true to __dst, in order, and returns how many there are. __dst has
+// room for __n elements and is either __src or does not overlap it. __keep is
+// called once per element, in order. Every element is copied whether it is
+// kept or not, so nothing branches on __keep. Where the target has a compress
+// instruction (AVX-512) or can build one from a permute (AVX2 with BMI2),
+// whole registers of 4- or 8-byte elements are packed at once; their
+// full-width stores never reach past the block just read.
+template <size_t __Cap, class __T, class __Keep>
+constexpr size_t __compact(const __T *__src, size_t __n, __T *__dst,
+                           __Keep &__keep) {
+  size_t __i = 0, __j = 0;
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__BMI2__))
+#if defined(__AVX512F__)
+  constexpr size_t __bytes = 64;
+#else
+  constexpr size_t __bytes = 32;
+#endif
+  constexpr size_t __w = __bytes / sizeof(__T);
+  if constexpr ((sizeof(__T) == 4 || sizeof(__T) == 8) &&
+                __use_blocks<__T, __Cap, __w>) {
+    if !consteval {
+      // The verdicts are gathered in lanes as wide as the elements, which
+      // vectorizes and reads back as one register.
+      using __lane = conditional_t<sizeof(__T) == 4, uint32_t, uint64_t>;
+      for (; __i + __w <= __n; __i += __w) {
+        alignas(__bytes) __lane __verdicts[__w];
+        for (size_t __k = 0; __k != __w; ++__k)
+          __verdicts[__k] = static_cast<bool>(__keep(__src[__i + __k]));
+#if defined(__AVX512F__)
+        const __m512i __b = _mm512_load_si512(__verdicts);
+        const __m512i __v = _mm512_loadu_si512(__src + __i);
+        unsigned __m;
+        if constexpr (sizeof(__T) == 4) {
+          __m = _mm512_test_epi32_mask(__b, __b);
+          _mm512_storeu_si512(
+              __dst + __j,
+              _mm512_maskz_compress_epi32(static_cast<__mmask16>(__m), __v));
+        } else {
+          __m = _mm512_test_epi64_mask(__b, __b);
+          _mm512_storeu_si512(
+              __dst + __j,
+              _mm512_maskz_compress_epi64(static_cast<__mmask8>(__m), __v));
+        }
+#else
+        const __m256i __b = _mm256_load_si256(
+            reinterpret_cast<const __m256i *>(static_cast<void *>(__verdicts)));
+        unsigned __m;
+        unsigned long long __lanes;
+        // Spread each mask bit over its lane's 32-bit indices, then gather
+        // the indices of the kept lanes to the front.
+        if constexpr (sizeof(__T) == 4) {
+          __m = static_cast<unsigned>(_mm256_movemask_ps(
+              _mm256_castsi256_ps(_mm256_slli_epi32(__b, 31))));
+          __lanes = _pdep_u64(__m, 0x0101010101010101ull) * 0xffu;
+        } else {
+          __m = static_cast<unsigned>(_mm256_movemask_pd(
+              _mm256_castsi256_pd(_mm256_slli_epi64(__b, 63))));
+          __lanes = _pdep_u64(__m, 0x0001000100010001ull) * 0xffffu;
+        }
+        const __m256i __idx = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(
+            static_cast<long long>(_pext_u64(0x0706050403020100ull, __lanes))));
+        const __m256i __v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(
+                static_cast<const void *>(__src + __i)));
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(static_cast<void *>(__dst + __j)),
+            _mm256_permutevar8x32_epi32(__v, __idx));
+#endif
+        __j += static_cast<size_t>(popcount(__m));
+      }
+    }
+  }
+#endif
+  for (; __i != __n; ++__i) {
+    const bool __k = static_cast<bool>(__keep(__src[__i]));
+    __dst[__j] = __src[__i];
+    __j += static_cast<size_t>(__k);
+  }
+  return __j;
+}
+
+// Capacities up to which sorting avoids std::sort's introsort bookkeeping.
+inline constexpr size_t __small_sort_capacity = 32;
+
+// Integers ordered by the default comparator, which sorting networks handle
+// with conditional moves. Integers that compare equal are indistinguishable,
+// so the network sort is also stable. Floating-point elements are left out:
+// compilers branch on a compare-exchange of them unless it is written as a
+// min and a max, which would turn a pair of 0.0 and -0.0 into two copies of
+// one of them.
+template <class __T, class __Compare>
+concept __network_sortable =
+    is_integral_v<__T> &&
+    (same_as<__Compare, ranges::less> || same_as<__Compare, less<>> ||
+     same_as<__Compare, less<__T>>);
+
+// Batcher's odd-even merge sorting network for __P elements, as the list of
+// (lower, upper) index pairs to compare-exchange in order. __F(__i, __j) is
+// called for each pair.
+template <size_t __P, class __F>
+constexpr void __for_each_batcher_pair(__F __f) {
+  for (size_t __p = 1; __p < __P; __p <<= 1)
+    for (size_t __k = __p; __k >= 1; __k >>= 1)
+      for (size_t __j = __k % __p; __j + __k < __P; __j += 2 * __k)
+        for (size_t __i = 0; __i < ::std::min(__k, __P - __j - __k); ++__i)
+          if ((__i + __j) / (2 * __p) == (__i + __j + __k) / (2 * __p))
+            __f(__i + __j, __i + __j + __k);
+}
+
+template <size_t __P> consteval size_t __batcher_size() {
+  size_t __n = 0;
+  __for_each_batcher_pair<__P>([&](size_t, size_t) { ++__n; });
+  return __n;
+}
+
+template <size_t __P>
+inline constexpr auto __batcher_network = [] {
+  array<pair<uint8_t, uint8_t>, __batcher_size<__P>()> __pairs{};
+  size_t __n = 0;
+  __for_each_batcher_pair<__P>([&](size_t __i, size_t __j) {
+    __pairs[__n++] = {uint8_t(__i), uint8_t(__j)};
+  });
+  return __pairs;
+}();
+
+// Orders __x and __y without branches.
+template <class __T> constexpr void __compare_exchange(__T &__x, __T &__y) {
+  const __T __lo = __y < __x ? __y : __x;
+  const __T __hi = __y < __x ? __x : __y;
+  __x = __lo;
+  __y = __hi;
+}
+
+// Sorts the __P elements at __a with the network, unrolled at compile time.
+template <size_t __P, class __T, size_t... __I>
+constexpr void __batcher_sort(__T *__a, index_sequence<__I...>) {
+  (__compare_exchange(__a[__batcher_network<__P>[__I].first],
+                      __a[__batcher_network<__P>[__I].second]),
+   ...);
+}
+
+// Sorts the __n <= __P elements at __p with the network for __P elements,
+// padding the rest with the largest value.
+template <size_t __P, class __T>
+constexpr void __network_sort_padded(__T *__p, size_t __n) {
+  __IV_EXPECT(__n <= __P);
+  __n = ::std::min(__n, __P); // lets the compiler see the bound
+  __T __a[__P];
+  for (size_t __i = 0; __i != __n; ++__i)
+    __a[__i] = __p[__i];
+  for (size_t __i = __n; __i != __P; ++__i)
+    __a[__i] = numeric_limits<__T>::max();
+  __batcher_sort<__P>(__a,
+                      make_index_sequence<__batcher_network<__P>.size()>{});
+  for (size_t __i = 0; __i != __n; ++__i)
+    __p[__i] = __a[__i];
+}
+
+// Sorts the __n <= __Cap elements at __p with the smallest network, of a
+// power-of-two size, that covers them.
+template <size_t __Cap, class __T>
+constexpr void __network_sort(__T *__p, size_t __n) {
+  static_assert(__Cap <= __small_sort_capacity);
+  if (__n < 2)
+    return;
+  const size_t __p2 = bit_ceil(__n);
+  if constexpr (__Cap > 16)
+    if (__p2 == 32)
+      return __network_sort_padded<32>(__p, __n);
+  if constexpr (__Cap > 8)
+    if (__p2 == 16)
+      return __network_sort_padded<16>(__p, __n);
+  if constexpr (__Cap > 4)
+    if (__p2 == 8)
+      return __network_sort_padded<8>(__p, __n);
+  if constexpr (__Cap > 2)
+    if (__p2 == 4)
+      return __network_sort_padded<4>(__p, __n);
+  __network_sort_padded<2>(__p, __n);
+}
+
+// Stable; cheaper than std::sort for the few elements of a small capacity.
+template <class __It, class __Compare>
+constexpr void __insertion_sort(__It __first, __It __last,
+                                __Compare &__comp) {
+  if (__first == __last)
+    return;
+  for (__It __i = __first + 1; __i != __last; ++__i) {
+    iter_value_t<__It> __v = ranges::iter_move(__i);
+    __It __j = __i;
+    for (; __j != __first && __comp(__v, *(__j - 1)); --__j)
+      *__j = ranges::iter_move(__j - 1);
+    *__j = ::std::move(__v);
+  }
+}
+
+// Keys radix_sort can order by their bits: integers, and IEC 559 binary32
+// and binary64 floating-point values.
+template <class __K>
+concept __radix_key_type =
+    (is_integral_v<__K> && !same_as<__K, bool>) ||
+    (is_floating_point_v<__K> && numeric_limits<__K>::is_iec559 &&
+     (sizeof(__K) == 4 || sizeof(__K) == 8));
+
+// The unsigned integer whose order matches that of the key __k. Signed
+// integers have their sign bit flipped. Floating-point values have all their
+// bits flipped when negative and only the sign bit otherwise, which orders
+// them -NaN < -inf < ... < -0.0 < 0.0 < ... < inf < NaN.
+template <__radix_key_type __K>
+constexpr auto __radix_key(__K __k) noexcept {
+  if constexpr (is_floating_point_v<__K>) {
+    using __U = conditional_t<sizeof(__K) == 4, uint32_t, uint64_t>;
+    constexpr __U __sign = __U(1) << (sizeof(__U) * 8 - 1);
+    const __U __b = bit_cast<__U>(__k);
+    return (__b & __sign) != 0 ? __U(~__b) : __U(__b | __sign);
+  } else {
+    using __U = make_unsigned_t<__K>;
+    if constexpr (is_signed_v<__K>)
+      return __U(__U(__k) ^ (__U(1) << (sizeof(__U) * 8 - 1)));
+    else
+      return __U(__k);
+  }
+}
+
+// Sizes below which radix_sort's passes cost more than an insertion sort.
+inline constexpr size_t __radix_sort_threshold = 64;
+
+template <class __L, size_t __N> struct __layout_size_type {
+  using type = __smallest_size_t<__N>;
+};
+template <class __L, size_t __N>
+  requires requires { typename __L::__stored_size_type; }
+struct __layout_size_type<__L, __N> {
+  using type = typename __L::__stored_size_type;
+  static_assert(__N <= numeric_limits<type>::max(),
+                "stored_size<Size>: Size cannot represent the capacity");
+};
+
+// The options of layout __L for capacity __N, with the defaults for those it
+// does not set.
+template <class __L, size_t __N> struct __layout_traits {
+  static constexpr bool __size_first = [] {
+    if constexpr (requires { __L::__size_first; })
+      return bool(__L::__size_first);
+    else
+      return false;
+  }();
+  using __size_type = typename __layout_size_type<__L, __N>::type;
+  // Minimum alignment of the element storage; 0 if the layout sets none.
+  static constexpr size_t __align = [] {
+    if constexpr (requires { __L::__align; })
+      return size_t(__L::__align);
+    else
+      return size_t{0};
+  }();
+  static constexpr bool __has_sentinel = requires { __L::__sentinel; };
+  // Byte multiple the element storage is padded to; 0 if not padded.
+  static constexpr size_t __pad_to = [] {
+    if constexpr (requires { __L::__pad_to; })
+      return size_t(__L::__pad_to);
+    else
+      return size_t{0};
+  }();
+};
+
+// Minimal iterator over a single value, used to insert __n copies of it.
+template <class __T> struct __repeat_iterator {
+  const __T *__value_;
+  constexpr const __T &operator*() const noexcept { return *__value_; }
+  constexpr __repeat_iterator &operator++() noexcept { return *this; }
+};
+
 } // namespace beman::__iv_detail
 
 // Types implementing the `inplace_vector`'s storage
@@ -376,6 +919,7 @@ template <class __T, size_t __N> struct __aligned_storage2 {
 template <class __T> struct __zero_sized {
 protected:
   using __size_type = uint8_t;
+  static constexpr size_t __padded_capacity = 0;
   static constexpr __T *__data() noexcept { return nullptr; }
   static constexpr __size_type __size() noexcept { return 0; }
   static constexpr void __unsafe_set_size(size_t __new_size) noexcept {
@@ -392,34 +936,85 @@ public:
   constexpr ~__zero_sized() = default;
 };
 
+// The members of a storage, the element data and the size, in the order
+// that the layout asks for, with the data aligned to at least __Align. The
+// user-provided constructor keeps the type a non-POD and the storages declare
+// it [[no_unique_address]], so that its tail padding stays reusable on the
+// Itanium C++ ABI.
+template <class __Data, class __Size, bool __SizeFirst, size_t __Align>
+struct __members {
+  static constexpr size_t __data_align =
+      __Align > alignof(__Data) ? __Align : alignof(__Data);
+  alignas(__data_align) __Data __data_;
+  __Size __size_ = 0;
+  constexpr __members() noexcept {}
+};
+template <class __Data, class __Size, size_t __Align>
+struct __members<__Data, __Size, true, __Align> {
+  static constexpr size_t __data_align =
+      __Align > alignof(__Data) ? __Align : alignof(__Data);
+  __Size __size_ = 0;
+  alignas(__data_align) __Data __data_;
+  constexpr __members() noexcept {}
+};
+
 // Storage for trivial types.
-template <class __T, size_t __N> struct __trivial {
+template <class __T, size_t __N, class __L = iv_layout::options<>>
+struct __trivial {
   static_assert(is_trivial_v<__T>,
                 "storage::trivial<T, C> requires Trivial<T>");
   static_assert(__N != size_t{0}, "__N  == 0, use __zero_sized");
 
+private:
+  static constexpr size_t __pad_to = __layout_traits<__L, __N>::__pad_to;
+  static_assert(__pad_to % sizeof(__T) == 0,
+                "pad_to<B> requires sizeof(T) to divide B");
+
 protected:
-  using __size_type = __smallest_size_t<__N>;
+  using __size_type = typename __layout_traits<__L, __N>::__size_type;
+  static constexpr size_t __padded_capacity =
+      __pad_to == 0
+          ? __N
+          : (__N * sizeof(__T) + __pad_to - 1) / __pad_to * __pad_to /
+                sizeof(__T);
 
 private:
-  // If value_type is const, then const array of non-const elements:
-  using __data_t = conditional_t<!is_const_v<__T>, array<__T, __N>,
-                                 const array<remove_const_t<__T>, __N>>;
-  alignas(alignof(__T)) __data_t __data_{};
-  __size_type __size_ = 0;
+  using __data_t = array<remove_const_t<__T>, __padded_capacity>;
+  // Elements in [size(), __N) are never read, so at run-time the array is
+  // left uninitialized instead of zero-filling up to __N elements on every
+  // construction, unless the layout pads it. Constant evaluation requires all
+  // subobjects to be initialized, so the constructor zeroes the array there.
+  [[no_unique_address]] __members<__data_t, __size_type,
+                                  __layout_traits<__L, __N>::__size_first,
+                                  __layout_traits<__L, __N>::__align>
+      __m_;
 
 protected:
-  constexpr const __T *__data() const noexcept { return __data_.data(); }
-  constexpr __T *__data() noexcept { return __data_.data(); }
-  constexpr __size_type __size() const noexcept { return __size_; }
+  constexpr const __T *__data() const noexcept { return __m_.__data_.data(); }
+  constexpr __T *__data() noexcept { return __m_.__data_.data(); }
+  constexpr __size_type __size() const noexcept { return __m_.__size_; }
   constexpr void __unsafe_set_size(size_t __new_size) noexcept {
     __IV_EXPECT(__size_type(__new_size) <= __N &&
                 "new_size out-of-bounds [0, N]");
-    __size_ = __size_type(__new_size);
+    if constexpr (__pad_to != 0) {
+      // Keep the vacated slots value-initialized.
+      if (__new_size < __m_.__size_)
+        fill(__m_.__data_.data() + __new_size,
+             __m_.__data_.data() + __m_.__size_, remove_const_t<__T>{});
+    }
+    __m_.__size_ = __size_type(__new_size);
   }
 
 public:
-  constexpr __trivial() noexcept = default;
+  constexpr __trivial() noexcept {
+    if constexpr (__pad_to != 0) {
+      __m_.__data_ = __data_t{};
+    } else {
+      if consteval {
+        __m_.__data_ = __data_t{};
+      }
+    }
+  }
   constexpr __trivial(__trivial const &) noexcept = default;
   constexpr __trivial &operator=(__trivial const &) noexcept = default;
   constexpr __trivial(__trivial &&) noexcept = default;
@@ -427,30 +1022,161 @@ public:
   constexpr ~__trivial() = default;
 };
 
+// Storage for trivially copyable, trivially destructible elements that are not
+// trivial, e.g. structs with default member initializers. Such elements are
+// implicit-lifetime types, so copying the storage bytes copies them and
+// nothing needs to run on destruction. The array sits in a union to keep
+// construction from default-initializing up to __N elements at run-time;
+// during constant evaluation the constructor activates it by assignment, as
+// for __trivial.
+template <class __T, size_t __N, class __L = iv_layout::options<>>
+struct __trivially_copyable {
+  static_assert(is_trivially_copyable_v<__T> &&
+                    is_trivially_destructible_v<__T> && !is_trivial_v<__T>,
+                "use storage::trivial or storage::non_trivial");
+  static_assert(__N != size_t{0}, "use storage::zero for __N==0");
+  static_assert(__layout_traits<__L, __N>::__pad_to == 0,
+                "pad_to<B> requires a trivial element type");
+
+protected:
+  using __size_type = typename __layout_traits<__L, __N>::__size_type;
+  static constexpr size_t __padded_capacity = __N;
+
+private:
+  using __array_t = array<remove_const_t<__T>, __N>;
+  union __data_t {
+    __array_t __a;
+    constexpr __data_t() noexcept {}
+  };
+  [[no_unique_address]] __members<__data_t, __size_type,
+                                  __layout_traits<__L, __N>::__size_first,
+                                  __layout_traits<__L, __N>::__align>
+      __m_;
+
+protected:
+  constexpr const __T *__data() const noexcept {
+    return __m_.__data_.__a.data();
+  }
+  constexpr __T *__data() noexcept { return __m_.__data_.__a.data(); }
+  constexpr __size_type __size() const noexcept { return __m_.__size_; }
+  constexpr void __unsafe_set_size(size_t __new_size) noexcept {
+    __IV_EXPECT(__size_type(__new_size) <= __N &&
+                "new_size out-of-bounds [0, N]");
+    __m_.__size_ = __size_type(__new_size);
+  }
+
+public:
+  constexpr __trivially_copyable() noexcept {
+    if consteval {
+      if constexpr (is_default_constructible_v<remove_const_t<__T>>)
+        __m_.__data_.__a = __array_t{};
+    }
+  }
+  constexpr __trivially_copyable(__trivially_copyable const &) noexcept =
+      default;
+  constexpr __trivially_copyable &
+  operator=(__trivially_copyable const &) noexcept = default;
+  constexpr __trivially_copyable(__trivially_copyable &&) noexcept = default;
+  constexpr __trivially_copyable &
+  operator=(__trivially_copyable &&) noexcept = default;
+  constexpr ~__trivially_copyable() = default;
+};
+
+// Storage without a size, for trivial elements with a sentinel value: the
+// slots in [size(), __N) hold the sentinel, which no element may equal.
+template <class __T, size_t __N, class __L>
+struct __sentinel_terminated {
+  static_assert(is_trivial_v<__T>,
+                "sentinel<V> requires a trivial element type");
+  static_assert(__N != size_t{0}, "use storage::zero for __N==0");
+  static_assert(__layout_traits<__L, __N>::__pad_to == 0,
+                "sentinel<V> cannot be combined with pad_to<B>");
+
+protected:
+  using __size_type = typename __layout_traits<__L, __N>::__size_type;
+  static constexpr size_t __padded_capacity = __N;
+
+private:
+  using __value_t = remove_const_t<__T>;
+  static constexpr __value_t __sentinel_value =
+      static_cast<__value_t>(__L::__sentinel);
+  using __data_t = array<__value_t, __N>;
+  static constexpr size_t __data_align =
+      __layout_traits<__L, __N>::__align > alignof(__data_t)
+          ? __layout_traits<__L, __N>::__align
+          : alignof(__data_t);
+  alignas(__data_align) __data_t __data_;
+
+protected:
+  constexpr const __T *__data() const noexcept { return __data_.data(); }
+  constexpr __T *__data() noexcept { return __data_.data(); }
+  // Counts the non-sentinel slots over the whole fixed-size array, without
+  // branches, so that the compiler can vectorize the comparison.
+  constexpr __size_type __size() const noexcept {
+    size_t __n = 0;
+    for (size_t __i = 0; __i != __N; ++__i)
+      __n += static_cast<size_t>(!(__data_[__i] == __sentinel_value));
+    return static_cast<__size_type>(__n);
+  }
+  // The elements are already in place when the vector grows, so only a
+  // shrink writes: it refills the vacated slots, which end at the first
+  // sentinel.
+  constexpr void __unsafe_set_size(size_t __new_size) noexcept {
+    __IV_EXPECT(__new_size <= __N && "new_size out-of-bounds [0, N]");
+    __IV_EXPECT((__new_size == 0 ||
+                 !(__data_[__new_size - 1] == __sentinel_value)) &&
+                "sentinel<V>: element equal to the sentinel");
+    for (size_t __i = __new_size;
+         __i != __N && !(__data_[__i] == __sentinel_value); ++__i)
+      __data_[__i] = __sentinel_value;
+  }
+
+public:
+  constexpr __sentinel_terminated() noexcept {
+    __data_.fill(__sentinel_value);
+  }
+  constexpr __sentinel_terminated(__sentinel_terminated const &) noexcept =
+      default;
+  constexpr __sentinel_terminated &
+  operator=(__sentinel_terminated const &) noexcept = default;
+  constexpr __sentinel_terminated(__sentinel_terminated &&) noexcept = default;
+  constexpr __sentinel_terminated &
+  operator=(__sentinel_terminated &&) noexcept = default;
+  constexpr ~__sentinel_terminated() = default;
+};
+
 /// Storage for non-trivial elements.
-template <class __T, size_t __N> struct __non_trivial {
-  static_assert(!is_trivial_v<__T>,
-                "use storage::trivial for Trivial<T> elements");
+template <class __T, size_t __N, class __L = iv_layout::options<>>
+struct __non_trivial {
+  static_assert(!is_trivial_v<__T> && !(is_trivially_copyable_v<__T> &&
+                                        is_trivially_destructible_v<__T>),
+                "use storage::trivial or storage::trivially_copyable");
   static_assert(__N != size_t{0}, "use storage::zero for __N==0");
+  static_assert(__layout_traits<__L, __N>::__pad_to == 0,
+                "pad_to<B> requires a trivial element type");
 
 protected:
-  using __size_type = __smallest_size_t<__N>;
+  using __size_type = typename __layout_traits<__L, __N>::__size_type;
+  static constexpr size_t __padded_capacity = __N;
 
 private:
-  using __data_t =
-      conditional_t<!is_const_v<__T>, __aligned_storage2<__T, __N>,
-                    const __aligned_storage2<remove_const_t<__T>, __N>>;
-  __data_t __data_{}; // BUGBUG: test SIMD types
-  __size_type __size_ = 0;
+  // Raw storage is never constant evaluated, so it is left uninitialized.
+  using __data_t = __aligned_storage2<remove_const_t<__T>, __N>;
+  [[no_unique_address]] __members<__data_t, __size_type,
+                                  __layout_traits<__L, __N>::__size_first,
+                                  __layout_traits<__L, __N>::__align>
+      __m_;
 
 protected:
-  constexpr const __T *__data() const noexcept { return __data_.__data(0); }
-  constexpr __T *__data() noexcept { return __data_.__data(0); }
-  constexpr __size_type __size() const noexcept { return __size_; }
+  constexpr const __T *__data() const noexcept {
+    return __m_.__data_.__data(0);
+  }
+  constexpr __T *__data() noexcept { return __m_.__data_.__data(0); }
+  constexpr __size_type __size() const noexcept { return __m_.__size_; }
   constexpr void __unsafe_set_size(size_t __new_size) noexcept {
     __IV_EXPECT(__size_type(__new_size) <= __N &&
                 "new_size out-of-bounds [0, __N)");
-    __size_ = __size_type(__new_size);
+    __m_.__size_ = __size_type(__new_size);
   }
 
 public:
@@ -459,14 +1185,28 @@ public:
   constexpr __non_trivial &operator=(__non_trivial const &) noexcept = default;
   constexpr __non_trivial(__non_trivial &&) noexcept = default;
   constexpr __non_trivial &operator=(__non_trivial &&) noexcept = default;
-  constexpr ~__non_trivial() = default;
+  constexpr ~__non_trivial()
+    requires(is_trivially_destructible_v<__T>)
+  = default;
+  constexpr ~__non_trivial()
+    requires(!is_trivially_destructible_v<__T>)
+  {
+    destroy(__data(), __data() + __size());
+  }
 };
 
-// Selects the vector storage.
-template <class __T, size_t __N>
-using _t = conditional_t<__N == 0, __zero_sized<__T>,
-                         conditional_t<is_trivial_v<__T>, __trivial<__T, __N>,
-                                       __non_trivial<__T, __N>>>;
+// Selects the vector storage: the cheapest tier that is correct for __T.
+template <class __T, size_t __N, class __L = iv_layout::options<>>
+using _t = conditional_t<
+    __N == 0, __zero_sized<__T>,
+    conditional_t<
+        __layout_traits<__L, __N>::__has_sentinel,
+        __sentinel_terminated<__T, __N, __L>,
+        conditional_t<is_trivial_v<__T>, __trivial<__T, __N, __L>,
+                      conditional_t<is_trivially_copyable_v<__T> &&
+                                        is_trivially_destructible_v<__T>,
+                                    __trivially_copyable<__T, __N, __L>,
+                                    __non_trivial<__T, __N, __L>>>>>;
 
 } // namespace beman::__iv_detail::__storage
 
@@ -475,13 +1215,17 @@ namespace beman {
 using namespace std;
 
 /// Dynamically-resizable fixed-__N vector with inplace storage.
-template <class __T, size_t __N>
-struct inplace_vector : private __iv_detail::__storage::_t<__T, __N> {
+///
+/// The optional __Layout controls how the storage is laid out; see
+/// `iv_layout`.
+template <class __T, size_t __N, class __Layout = iv_layout::options<>>
+struct inplace_vector
+    : private __iv_detail::__storage::_t<__T, __N, __Layout> {
 private:
   static_assert(is_nothrow_destructible_v<__T>,
                 "T must be nothrow destructible");
-  using __base_t = __iv_detail::__storage::_t<__T, __N>;
-  using __self = inplace_vector<__T, __N>;
+  using __base_t = __iv_detail::__storage::_t<__T, __N, __Layout>;
+  using __self = inplace_vector<__T, __N, __Layout>;
   using __base_t::__data;
   using __base_t::__size;
   using __base_t::__unsafe_set_size;
@@ -522,7 +1266,8 @@ public:
   // from base-class, trivial if is_trivially_destructible_v<__T> &&
   // is_trivially_copy_assignable_v<__T>
   //   constexpr inplace_vector& operator=(inplace_vector&& __other)
-  //   noexcept(__N == 0 || is_nothrow_move_assignable_v<__T>);
+  //   noexcept(__N == 0 || (is_nothrow_move_assignable_v<__T> &&
+  //                         is_nothrow_move_constructible_v<__T>));
   // template <class __InputIterator> // BUGBUG: why not model input_iterator
   //  constexpr void assign(__InputIterator __first, __InputIterator l__ast);
   // template<__iv_detail::__container_compatible_range<__T> __R>
@@ -561,6 +1306,12 @@ public:
   constexpr size_type size() const noexcept { return __size(); }
   static constexpr size_type max_size() noexcept { return __N; }
   static constexpr size_type capacity() noexcept { return __N; }
+  /// The number of slots data() points to; larger than capacity() with
+  /// iv_layout::pad_to, in which case the slots in [size(),
+  /// padded_capacity()) hold value-initialized elements and may be read.
+  static constexpr size_type padded_capacity() noexcept {
+    return __base_t::__padded_capacity;
+  }
   // constexpr void resize(size_type __sz);
   // constexpr void resize(size_type __sz, const __T& __c);
   constexpr void reserve(size_type __n) {
@@ -595,6 +1346,153 @@ public:
   constexpr __T *data() noexcept { return __data(); }
   constexpr const __T *data() const noexcept { return __data(); }
 
+  // Search and reduction over arithmetic elements (extension). With
+  // iv_layout::pad_to, find and sum run over the zeroed padded slots too,
+  // in whole blocks.
+private:
+  static constexpr bool __padded =
+      __iv_detail::__layout_traits<__Layout, __N>::__pad_to != 0;
+
+public:
+  constexpr size_type index_of(const __T &__v) const noexcept
+    requires(is_arithmetic_v<__T>)
+  {
+    if constexpr (__padded) {
+      // A match in the padding is past size(): no match.
+      constexpr size_t __cap = padded_capacity();
+      return static_cast<size_type>(::std::min<size_t>(
+          __iv_detail::__find_index<__cap>(data(), __cap, __v), size()));
+    } else
+      return static_cast<size_type>(
+          __iv_detail::__find_index<__N>(data(), size(), __v));
+  }
+  constexpr iterator find(const __T &__v) noexcept
+    requires(is_arithmetic_v<__T>)
+  {
+    return begin() + index_of(__v);
+  }
+  constexpr const_iterator find(const __T &__v) const noexcept
+    requires(is_arithmetic_v<__T>)
+  {
+    return begin() + index_of(__v);
+  }
+  constexpr bool contains(const __T &__v) const noexcept
+    requires(is_arithmetic_v<__T>)
+  {
+    return index_of(__v) != size();
+  }
+  constexpr size_type count(const __T &__v) const noexcept
+    requires(is_arithmetic_v<__T>)
+  {
+    return static_cast<size_type>(__iv_detail::__count<__N>(data(), size(), __v));
+  }
+  constexpr remove_const_t<__T> sum() const noexcept
+    requires(is_arithmetic_v<__T>)
+  {
+    return __iv_detail::__sum<padded_capacity()>(
+        data(), __padded ? padded_capacity() : size());
+  }
+  constexpr ranges::min_max_result<remove_const_t<__T>> minmax() const noexcept
+    requires(is_arithmetic_v<__T>)
+  {
+    __IV_EXPECT(!empty() && "minmax of empty inplace_vector");
+    return __iv_detail::__minmax<__N>(data(), size());
+  }
+  constexpr remove_const_t<__T> min() const noexcept
+    requires(is_arithmetic_v<__T>)
+  {
+    return minmax().min;
+  }
+  constexpr remove_const_t<__T> max() const noexcept
+    requires(is_arithmetic_v<__T>)
+  {
+    return minmax().max;
+  }
+
+  // Sorting (extension). Small capacities avoid std::sort: integers under the
+  // default order go through a sorting network, other elements through
+  // insertion sort.
+  template <class __Compare = ranges::less>
+    requires sortable<iterator, __Compare>
+  constexpr void sort(__Compare __comp = {}) {
+    if constexpr (__N <= __iv_detail::__small_sort_capacity &&
+                  __iv_detail::__network_sortable<remove_const_t<__T>,
+                                                  __Compare>)
+      __iv_detail::__network_sort<__N>(data(), size());
+    else if constexpr (__N <= __iv_detail::__small_sort_capacity)
+      __iv_detail::__insertion_sort(begin(), end(), __comp);
+    else
+      ranges::sort(begin(), end(), __comp);
+  }
+  template <class __Compare = ranges::less>
+    requires sortable<iterator, __Compare>
+  constexpr void stable_sort(__Compare __comp = {}) {
+    if constexpr (__N <= __iv_detail::__small_sort_capacity &&
+                  __iv_detail::__network_sortable<remove_const_t<__T>,
+                                                  __Compare>)
+      __iv_detail::__network_sort<__N>(data(), size());
+    else if constexpr (__N <= __iv_detail::__small_sort_capacity)
+      __iv_detail::__insertion_sort(begin(), end(), __comp);
+    else
+      ranges::stable_sort(begin(), end(), __comp);
+  }
+
+  // Stable LSD radix sort (extension) by the integer or floating-point key
+  // that __key extracts, one byte per pass; floating-point keys are ordered
+  // as by __iv_detail::__radix_key. The scratch buffer is another
+  // inplace_vector<T, N>, so nothing is allocated; passes whose byte is the
+  // same for every element are skipped. Small sizes use insertion sort.
+  template <class __Key = identity>
+    requires(!is_const_v<__T> && copyable<__T> &&
+             __iv_detail::__radix_key_type<
+                 remove_cvref_t<invoke_result_t<__Key &, const __T &>>>)
+  constexpr void radix_sort(__Key __key = {}) {
+    auto __radix_key = [&](const __T &__e) {
+      return __iv_detail::__radix_key(invoke(__key, __e));
+    };
+    const size_type __n = size();
+    if (__n < __iv_detail::__radix_sort_threshold) {
+      auto __less = [&](const __T &__a, const __T &__b) {
+        return __radix_key(__a) < __radix_key(__b);
+      };
+      __iv_detail::__insertion_sort(begin(), end(), __less);
+      return;
+    }
+    using __key_t = decltype(__radix_key(front()));
+    constexpr size_t __passes = sizeof(__key_t);
+    using __count_t =
+        conditional_t<(__N <= numeric_limits<uint32_t>::max()), uint32_t,
+                      size_t>;
+    // Histograms of every byte, from a single pass over the keys.
+    __count_t __hist[__passes][256] = {};
+    for (const __T &__e : *this) {
+      const __key_t __k = __radix_key(__e);
+      for (size_t __d = 0; __d != __passes; ++__d)
+        ++__hist[__d][(__k >> (8 * __d)) & 0xff];
+    }
+    inplace_vector<__T, __N> __scratch(begin(), end());
+    __T *__src = data();
+    __T *__dst = __scratch.data();
+    for (size_t __d = 0; __d != __passes; ++__d) {
+      __count_t(&__offsets)[256] = __hist[__d];
+      const size_t __shift = 8 * __d;
+      if (__offsets[(__radix_key(__src[0]) >> __shift) & 0xff] == __n)
+        continue;
+      __count_t __sum = 0;
+      for (__count_t &__o : __offsets) {
+        const __count_t __c = __o;
+        __o = __sum;
+        __sum = static_cast<__count_t>(__sum + __c);
+      }
+      for (size_type __i = 0; __i != __n; ++__i)
+        __dst[__offsets[(__radix_key(__src[__i]) >> __shift) & 0xff]++] =
+            ::std::move(__src[__i]);
+      ::std::swap(__src, __dst);
+    }
+    if (__src != data())
+      ::std::move(__src, __src + __n, data());
+  }
+
   // [containers.sequences.inplace_vector.modifiers], modifiers
   // template <class... __Args>
   //  constexpr __T& emplace_back(__Args&&... __args);
@@ -608,6 +1506,8 @@ public:
   //  constexpr __T* try_emplace_back(__Args&&... __args);
   // constexpr __T* try_push_back(const __T& __value);
   // constexpr __T* try_push_back(__T&& __value);
+  // template<__iv_detail::__container_compatible_range<__T> __R>
+  //  constexpr ranges::borrowed_iterator_t<__R> try_append_range(__R&& __rg);
 
   // template<class... __Args>
   //  constexpr __T& unchecked_emplace_back(__Args&&... __args);
@@ -635,10 +1535,37 @@ public:
 
   constexpr friend bool operator==(const inplace_vector &__x,
                                    const inplace_vector &__y) {
-    return __x.size() == __y.size() && ::std::ranges::equal(__x, __y);
+    const size_type __sz = __x.size();
+    if (__sz != __y.size())
+      return false;
+    if constexpr (__N != 0 &&
+                  __iv_detail::__bitwise_equality_comparable<__T>) {
+      if !consteval {
+        return memcmp(__x.data(), __y.data(), __sz * sizeof(__T)) == 0;
+      }
+    }
+    return ::std::ranges::equal(__x, __y);
+  }
+  // Lexicographic, stopping at the first element that differs.
+  constexpr friend auto /*synth-three-way-result<T>*/
+  operator<=>(const inplace_vector &__x, const inplace_vector &__y)
+    requires requires(const __T &__t) {
+      __iv_detail::__synth_three_way(__t, __t);
+    }
+  {
+    if constexpr (__N != 0 && __iv_detail::__bytewise_orderable<__T>) {
+      if !consteval {
+        const size_type __x_sz = __x.size();
+        const size_type __y_sz = __y.size();
+        const size_type __n = ::std::min(__x_sz, __y_sz);
+        const int __r = memcmp(__x.data(), __y.data(), __n);
+        return __r != 0 ? __r <=> 0 : __x_sz <=> __y_sz;
+      }
+    }
+    return ::std::lexicographical_compare_three_way(
+        __x.begin(), __x.end(), __y.begin(), __y.end(),
+        __iv_detail::__synth_three_way);
   }
-  // constexpr friend auto /*synth-three-way-result<T>*/
-  //  operator<=>(const inplace_vector& __x, const inplace_vector& __y);
   constexpr friend void swap(inplace_vector &__x, inplace_vector &__y) noexcept(
       __N == 0 ||
       (is_nothrow_swappable_v<__T> && is_nothrow_move_constructible_v<__T>)) {
@@ -665,12 +1592,156 @@ private: // Utilities
   __unsafe_destroy(__T *__first,
                    __T *__last) noexcept(is_nothrow_destructible_v<__T>) {
     __assert_iterator_pair_in_range(__first, __last);
-    if constexpr (__N > 0 && !is_trivial_v<__T>) {
+    if constexpr (__N > 0 && !is_trivially_destructible_v<__T>) {
       for (; __first != __last; ++__first)
         __first->~__T();
     }
   }
 
+  // Inserts the __n elements produced by __first at __position: checks the
+  // capacity once, shifts the tail once to open a gap, and places the new
+  // elements directly into it. __first only needs operator* and operator++.
+  //
+  // Every slot in [0, size()) holds a live element at every step, so an
+  // exception leaves the vector valid.
+  template <class __It>
+  constexpr iterator __insert_n(const_iterator __position, size_type __n,
+                                __It __first) {
+    __assert_iterator_in_range(__position);
+    const size_type __sz = size();
+    if (__n > __N - __sz) [[unlikely]]
+      throw bad_alloc();
+    iterator __p = begin() + (__position - cbegin());
+    iterator __e = end();
+    const size_type __tail = static_cast<size_type>(__e - __p);
+    if constexpr (__iv_detail::__trivially_relocatable<__T>) {
+      if !consteval {
+        __iv_detail::__relocate(__p, __e, __p + __n);
+        size_type __i = 0;
+        try {
+          for (; __i != __n; ++__i, ++__first)
+            construct_at(__p + __i, *__first);
+        } catch (...) {
+          destroy(__p, __p + __i);
+          __iv_detail::__relocate(__p + __n, __e + __n, __p);
+          throw;
+        }
+        __unsafe_set_size(__sz + __n);
+        return __p;
+      }
+    }
+    if (__tail > __n) {
+      // The last __n elements move to raw storage, the rest of the tail
+      // shifts over live elements, and the gap is assigned to.
+      for (iterator __s = __e - __n; __s != __e; ++__s)
+        unchecked_emplace_back(::std::move(*__s));
+      move_backward(__p, __e - __n, __e);
+      for (size_type __i = 0; __i != __n; ++__i, ++__first)
+        __iv_detail::__assign_from(__p[__i], *__first);
+    } else {
+      // The new elements past the old end are constructed first, then the
+      // tail moves behind them, and the rest of the gap is assigned to.
+      __It __mid = __first;
+      for (size_type __i = 0; __i != __tail; ++__i)
+        ++__mid;
+      for (size_type __i = __tail; __i != __n; ++__i, ++__mid)
+        unchecked_emplace_back(*__mid);
+      for (iterator __s = __p; __s != __e; ++__s)
+        unchecked_emplace_back(::std::move(*__s));
+      for (size_type __i = 0; __i != __tail; ++__i, ++__first)
+        __iv_detail::__assign_from(__p[__i], *__first);
+    }
+    return __p;
+  }
+
+  // Constructs the __n elements produced by __first at end(), which the
+  // caller checked there is room for, and sets the size once. Contiguous
+  // elements of a trivially copyable __T are copied with one memcpy. If a
+  // construction throws, the elements constructed before it stay appended.
+  // Returns the iterator past the last element used.
+  template <class __It>
+  constexpr __It __unchecked_append_n(__It __first, size_type __n) {
+    const size_type __sz = size();
+    __T *const __p = data() + __sz;
+    if constexpr (is_trivially_copyable_v<__T> && contiguous_iterator<__It> &&
+                  same_as<remove_cv_t<iter_value_t<__It>>,
+                          remove_const_t<__T>>) {
+      if !consteval {
+        if (__n != 0)
+          memcpy(static_cast<void *>(const_cast<remove_const_t<__T> *>(__p)),
+                 static_cast<const void *>(::std::to_address(__first)),
+                 __n * sizeof(__T));
+        __unsafe_set_size(__sz + __n);
+        return __first + static_cast<iter_difference_t<__It>>(__n);
+      }
+    }
+    size_type __i = 0;
+    try {
+      for (; __i != __n; ++__i, ++__first)
+        construct_at(__p + __i, *__first);
+    } catch (...) {
+      __unsafe_set_size(__sz + __i);
+      throw;
+    }
+    __unsafe_set_size(__sz + __n);
+    return __first;
+  }
+
+  // Constructs the elements [size(), __sz) and then sets the size once:
+  // value-initialized, or default-initialized if __Default, which at
+  // run-time leaves trivially default constructible ones as the storage
+  // holds them. If a construction throws, those already made are destroyed.
+  template <bool __Default> constexpr void __construct_back(size_type __sz) {
+    __T *const __first = data() + size();
+    __T *const __last = data() + __sz;
+    if constexpr (__Default && is_trivially_default_constructible_v<__T>) {
+      if !consteval {
+        __unsafe_set_size(__sz);
+        return;
+      }
+    }
+    __T *__p = __first;
+    try {
+      for (; __p != __last; ++__p) {
+        if constexpr (__Default) {
+          if consteval {
+            construct_at(__p);
+          } else {
+            ::new (static_cast<void *>(const_cast<remove_const_t<__T> *>(__p)))
+                __T;
+          }
+        } else {
+          construct_at(__p);
+        }
+      }
+    } catch (...) {
+      destroy(__first, __p);
+      throw;
+    }
+    __unsafe_set_size(__sz);
+  }
+
+  // Replaces the elements with the __n ones produced by __first, assigning
+  // over the existing elements and only constructing or destroying the
+  // difference, so that elements can reuse resources they own (e.g. the
+  // buffer of a std::string). __first only needs operator* and operator++.
+  template <class __It>
+  constexpr void __assign_n(size_type __n, __It __first) {
+    if (__n > __N) [[unlikely]]
+      throw bad_alloc();
+    const size_type __sz = size();
+    iterator __p = begin();
+    for (size_type __i = 0; __i != ::std::min(__n, __sz); ++__i, ++__first)
+      __iv_detail::__assign_from(__p[__i], *__first);
+    if (__n > __sz) {
+      for (size_type __i = __sz; __i != __n; ++__i, ++__first)
+        unchecked_emplace_back(*__first);
+    } else {
+      __unsafe_destroy(__p + __n, __p + __sz);
+      __unsafe_set_size(__n);
+    }
+  }
+
 public:
   // Implementation
 
@@ -680,10 +1751,13 @@ public:
   constexpr __T &unchecked_emplace_back(__Args &&...__args)
     requires(constructible_from<__T, __Args...>)
   {
-    __IV_EXPECT(size() < capacity() && "inplace_vector out-of-memory");
-    construct_at(end(), ::std::forward<__Args>(__args)...);
-    __unsafe_set_size(size() + size_type(1));
-    return back();
+    // The size is read once: with a sentinel layout it is derived from the
+    // slots, which construction changes.
+    const size_type __sz = size();
+    __IV_EXPECT(__sz < capacity() && "inplace_vector out-of-memory");
+    __T *__p = construct_at(data() + __sz, ::std::forward<__Args>(__args)...);
+    __unsafe_set_size(__sz + size_type(1));
+    return *__p;
   }
 
   template <class... __Args>
@@ -735,18 +1809,180 @@ public:
     return unchecked_emplace_back(::std::forward<__T &&>(__x));
   }
 
+  // Sized ranges are checked against the capacity once, up front, and
+  // appended in bulk.
   template <__iv_detail::__container_compatible_range<__T> __R>
   constexpr void append_range(__R &&__rg)
     requires(constructible_from<__T, ranges::range_reference_t<__R>>)
   {
     if constexpr (ranges::sized_range<__R>) {
-      if (size() + ranges::size(__rg) > capacity()) [[unlikely]]
+      const auto __n = ranges::size(__rg);
+      if (__n > __N - size()) [[unlikely]]
         throw bad_alloc();
+      __unchecked_append_n(ranges::begin(__rg), static_cast<size_type>(__n));
+    } else {
+      for (auto &&__e : __rg)
+        emplace_back(::std::forward<decltype(__e)>(__e));
     }
-    for (auto &&__e : __rg) {
-      if (size() == capacity()) [[unlikely]]
+  }
+
+  // Appends the elements of __rg until the vector is full, and returns an
+  // iterator to the first one not appended.
+  template <__iv_detail::__container_compatible_range<__T> __R>
+  constexpr ranges::borrowed_iterator_t<__R> try_append_range(__R &&__rg)
+    requires(constructible_from<__T, ranges::range_reference_t<__R>>)
+  {
+    if constexpr (ranges::sized_range<__R>) {
+      const size_type __n = static_cast<size_type>(::std::min<size_t>(
+          static_cast<size_t>(ranges::size(__rg)), __N - size()));
+      return __unchecked_append_n(ranges::begin(__rg), __n);
+    } else {
+      auto __it = ranges::begin(__rg);
+      const auto __end = ranges::end(__rg);
+      for (; __it != __end && size() != capacity(); ++__it)
+        unchecked_emplace_back(*__it);
+      return __it;
+    }
+  }
+
+  // Appends __n elements made by __f (extension): __f(__i) for the __i-th
+  // new element if __f takes an index, __f() otherwise. The capacity is
+  // checked once and the elements are constructed in place by one loop that
+  // sets the size at the end, which compilers can vectorize; a push_back per
+  // element keeps the check and the size update inside the loop.
+  template <class __F>
+    requires((invocable<__F &, size_type> &&
+              constructible_from<__T, invoke_result_t<__F &, size_type>>) ||
+             (invocable<__F &> &&
+              constructible_from<__T, invoke_result_t<__F &>>))
+  constexpr void append_generate(size_type __n, __F __f) {
+    if (__n > __N - size()) [[unlikely]]
+      throw bad_alloc();
+    auto __indices = views::iota(size_type{0}, __n);
+    if constexpr (invocable<__F &, size_type>) {
+      auto __made = views::transform(__indices, ::std::ref(__f));
+      __unchecked_append_n(ranges::begin(__made), __n);
+    } else {
+      auto __call = [&__f](size_type) -> decltype(auto) { return __f(); };
+      auto __made = views::transform(__indices, __call);
+      __unchecked_append_n(ranges::begin(__made), __n);
+    }
+  }
+
+  // Appends __f(__e) for each element __e of __rg (extension). A sized
+  // range is checked against the capacity once and constructed like
+  // append_generate; others go through emplace_back.
+  template <ranges::input_range __R, class __F>
+    requires(invocable<__F &, ranges::range_reference_t<__R>> &&
+             constructible_from<
+                 __T, invoke_result_t<__F &, ranges::range_reference_t<__R>>>)
+  constexpr void append_transform(__R &&__rg, __F __f) {
+    if constexpr (ranges::sized_range<__R>) {
+      const auto __n = ranges::size(__rg);
+      if (__n > __N - size()) [[unlikely]]
+        throw bad_alloc();
+      auto __made = views::transform(__rg, ::std::ref(__f));
+      __unchecked_append_n(ranges::begin(__made), static_cast<size_type>(__n));
+    } else {
+      for (auto &&__e : __rg)
+        emplace_back(::std::invoke(__f, ::std::forward<decltype(__e)>(__e)));
+    }
+  }
+
+  // Appends the elements of __rg, which must fit (extension).
+  template <__iv_detail::__container_compatible_range<__T> __R>
+  constexpr void unchecked_append_range(__R &&__rg)
+    requires(constructible_from<__T, ranges::range_reference_t<__R>>)
+  {
+    if constexpr (ranges::sized_range<__R>) {
+      const auto __n = ranges::size(__rg);
+      __IV_EXPECT(__n <= __N - size() && "inplace_vector out-of-memory");
+      __unchecked_append_n(ranges::begin(__rg), static_cast<size_type>(__n));
+    } else {
+      for (auto &&__e : __rg)
+        unchecked_emplace_back(::std::forward<decltype(__e)>(__e));
+    }
+  }
+
+private:
+  // Layouts whose slots past size() hold a fixed value: zero when padded,
+  // the sentinel otherwise. Writes past size() that do not grow the vector
+  // must leave that value behind.
+  static constexpr bool __fixed_vacant =
+      __padded || __iv_detail::__layout_traits<__Layout, __N>::__has_sentinel;
+  static constexpr remove_const_t<__T> __vacant_value() noexcept {
+    if constexpr (__iv_detail::__layout_traits<__Layout, __N>::__has_sentinel)
+      return static_cast<remove_const_t<__T>>(__Layout::__sentinel);
+    else
+      return remove_const_t<__T>{};
+  }
+
+public:
+  // Appends __x if __cond, without branching on __cond (extension): __x is
+  // written to end() either way and the size grows by __cond, so that
+  // filter loops do not mispredict. Throws bad_alloc if __cond and the
+  // vector is full.
+  constexpr void push_back_if(bool __cond, const __T &__x)
+    requires(is_trivially_copyable_v<__T>)
+  {
+    const size_type __sz = size();
+    if (__sz == capacity()) [[unlikely]] {
+      if (__cond)
         throw bad_alloc();
-      emplace_back(::std::forward<decltype(__e)>(__e));
+      return;
+    }
+    if constexpr (__fixed_vacant)
+      construct_at(data() + __sz, __cond ? __x : __vacant_value());
+    else
+      construct_at(data() + __sz, __x);
+    __unsafe_set_size(__sz + static_cast<size_type>(__cond));
+  }
+
+  // Appends the elements of __rg for which __pred holds, in order
+  // (extension). Throws bad_alloc when one does not fit; those before it
+  // stay appended. Contiguous ranges of arithmetic elements are left-packed
+  // straight into the free slots like erase_if packs, other ranges of
+  // trivially copyable elements go through push_back_if, and the rest
+  // branch on __pred.
+  template <ranges::input_range __R, class __Predicate>
+    requires(constructible_from<__T, ranges::range_reference_t<__R>>)
+  constexpr void append_if(__R &&__rg, __Predicate __pred) {
+    using __value_t = remove_const_t<__T>;
+    if constexpr (is_arithmetic_v<__T> && ranges::contiguous_range<__R> &&
+                  ranges::sized_range<__R> &&
+                  same_as<remove_cv_t<ranges::range_value_t<__R>>,
+                          __value_t>) {
+      const __value_t *__src = ranges::data(__rg);
+      size_t __n = static_cast<size_t>(ranges::size(__rg));
+      auto __keep = [&__pred](const __value_t &__e) { return __pred(__e); };
+      while (__n != 0) {
+        // Pack as much of the range as there are free slots.
+        const size_type __sz = size();
+        const size_t __m = ::std::min<size_t>(__n, __N - __sz);
+        if (__m == 0) {
+          for (; __n != 0; ++__src, --__n)
+            if (__pred(*__src))
+              throw bad_alloc();
+          return;
+        }
+        __value_t *__dst = const_cast<__value_t *>(data()) + __sz;
+        const size_t __kept =
+            __iv_detail::__compact<__N>(__src, __m, __dst, __keep);
+        if constexpr (__fixed_vacant)
+          ::std::fill(__dst + __kept, __dst + __m, __vacant_value());
+        __unsafe_set_size(__sz + __kept);
+        __src += __m;
+        __n -= __m;
+      }
+    } else if constexpr (is_trivially_copyable_v<__T> &&
+                         same_as<remove_cvref_t<ranges::range_reference_t<__R>>,
+                                 __value_t>) {
+      for (auto &&__e : __rg)
+        push_back_if(static_cast<bool>(__pred(__e)), __e);
+    } else {
+      for (auto &&__e : __rg)
+        if (__pred(__e))
+          emplace_back(::std::forward<decltype(__e)>(__e));
     }
   }
 
@@ -755,11 +1991,13 @@ public:
     requires(constructible_from<__T, __Args...> && movable<__T>)
   {
     __assert_iterator_in_range(__position);
-    auto __b = end();
-    emplace_back(std::forward<__Args>(__args)...);
-    auto __pos = begin() + (__position - begin());
-    rotate(__pos, __b, end());
-    return __pos;
+    if (size() == __N) [[unlikely]]
+      throw bad_alloc();
+    if (__position == cend())
+      return &unchecked_emplace_back(::std::forward<__Args>(__args)...);
+    // The arguments may refer to elements that the insertion moves.
+    __T __tmp(::std::forward<__Args>(__args)...);
+    return __insert_n(__position, 1, make_move_iterator(addressof(__tmp)));
   }
 
   template <class __InputIterator>
@@ -768,19 +2006,22 @@ public:
     requires(constructible_from<__T, iter_reference_t<__InputIterator>> &&
              movable<__T>)
   {
-    __assert_iterator_in_range(__position);
-    __assert_valid_iterator_pair(__first, __last);
-    if constexpr (random_access_iterator<__InputIterator>) {
-      if (size() + static_cast<size_type>(distance(__first, __last)) >
-          capacity()) [[unlikely]]
-        throw bad_alloc{};
+    if constexpr (forward_iterator<__InputIterator>) {
+      return __insert_n(__position,
+                        static_cast<size_type>(distance(__first, __last)),
+                        __first);
+    } else {
+      // Single-pass: the number of elements is unknown up-front, so append
+      // them and rotate them into place.
+      __assert_iterator_in_range(__position);
+      const auto __offset = __position - cbegin();
+      auto __b = end();
+      for (; __first != __last; ++__first)
+        emplace_back(*__first);
+      auto __pos = begin() + __offset;
+      rotate(__pos, __b, end());
+      return __pos;
     }
-    auto __b = end();
-    for (; __first != __last; ++__first)
-      emplace_back(::std::move(*__first));
-    auto __pos = begin() + (__position - begin());
-    rotate(__pos, __b, end());
-    return __pos;
   }
 
   template <__iv_detail::__container_compatible_range<__T> __R>
@@ -804,13 +2045,12 @@ public:
                             const __T &__x)
     requires(constructible_from<__T, const __T &> && copyable<__T>)
   {
-    __assert_iterator_in_range(__position);
-    auto __b = end();
-    for (size_type __i = 0; __i < __n; ++__i)
-      emplace_back(__x);
-    auto __pos = begin() + (__position - begin());
-    rotate(__pos, __b, end());
-    return __pos;
+    if (__n == 0)
+      return begin() + (__position - cbegin());
+    // __x may refer to an element that the insertion moves.
+    const __T __value(__x);
+    return __insert_n(__position, __n,
+                      __iv_detail::__repeat_iterator<__T>{addressof(__value)});
   }
 
   constexpr iterator insert(const_iterator __position, const __T &__x)
@@ -867,11 +2107,19 @@ public:
   {
     __assert_iterator_pair_in_range(__first, __last);
     iterator __f = begin() + (__first - begin());
-    if (__first != __last) {
-      __unsafe_destroy(::std::move(__f + (__last - __first), end(), __f),
-                       end());
-      __unsafe_set_size(size() - static_cast<size_type>(__last - __first));
+    if (__first == __last)
+      return __f;
+    iterator __l = __f + (__last - __first);
+    if constexpr (__iv_detail::__trivially_relocatable<__T>) {
+      if !consteval {
+        __unsafe_destroy(__f, __l);
+        __iv_detail::__relocate(__l, end(), __f);
+        __unsafe_set_size(size() - static_cast<size_type>(__l - __f));
+        return __f;
+      }
     }
+    __unsafe_destroy(::std::move(__l, end(), __f), end());
+    __unsafe_set_size(size() - static_cast<size_type>(__l - __f));
     return __f;
   }
 
@@ -881,6 +2129,64 @@ public:
     return erase(__position, __position + 1);
   }
 
+  // Erases the element at __position by moving the last element into its
+  // place: one move instead of shifting the tail, at the cost of the order.
+  // Returns an iterator to the moved element, or end() if the last was
+  // erased. Erasing several this way, highest position first, leaves the
+  // earlier positions valid.
+  constexpr iterator erase_unordered(const_iterator __position)
+    requires(movable<__T>)
+  {
+    __assert_iterator_in_range(__position);
+    __IV_EXPECT(__position != end() && "erase_unordered of end()");
+    iterator __p = begin() + (__position - begin());
+    iterator __last = end() - 1;
+    if (__p != __last) {
+      if constexpr (__iv_detail::__trivially_relocatable<__T>) {
+        if !consteval {
+          __unsafe_destroy(__p, __p + 1);
+          __iv_detail::__relocate(__last, end(), __p);
+          __unsafe_set_size(size() - 1);
+          return __p;
+        }
+      }
+      *__p = ::std::move(*__last);
+    }
+    __unsafe_destroy(__last, end());
+    __unsafe_set_size(size() - 1);
+    return __p;
+  }
+
+  // Erases the elements at __indices, which must be strictly increasing and
+  // less than size(), keeping the order of the others. Each element after
+  // the first index is moved at most once, and the vacated tail destroyed
+  // once. Returns the number of elements erased.
+  template <ranges::input_range __R>
+    requires integral<ranges::range_value_t<__R>>
+  constexpr size_type erase_indices(__R &&__indices)
+    requires(movable<__T>)
+  {
+    const size_type __sz = size();
+    auto __it = ranges::begin(__indices);
+    const auto __end = ranges::end(__indices);
+    if (__it == __end)
+      return 0;
+    // Elements [__next, *__it) move down to __out.
+    iterator __out = begin() + static_cast<size_type>(*__it);
+    iterator __next = __out;
+    for (; __it != __end; ++__it) {
+      iterator __hole = begin() + static_cast<size_type>(*__it);
+      __IV_EXPECT(__next <= __hole && __hole < end() &&
+                  "indices not increasing or out of range");
+      __out = ::std::move(__next, __hole, __out);
+      __next = __hole + 1;
+    }
+    __out = ::std::move(__next, end(), __out);
+    __unsafe_destroy(__out, end());
+    __unsafe_set_size(static_cast<size_type>(__out - begin()));
+    return static_cast<size_type>(__sz - size());
+  }
+
   constexpr void clear() noexcept {
     __unsafe_destroy(begin(), end());
     __unsafe_set_size(0);
@@ -908,14 +2214,58 @@ public:
     else if (__sz > __N) [[unlikely]]
       throw bad_alloc{};
     else if (__sz > size())
-      while (size() != __sz)
-        emplace_back(__T{});
+      __construct_back<false>(__sz);
     else {
       __unsafe_destroy(begin() + __sz, end());
       __unsafe_set_size(__sz);
     }
   }
 
+  // Like resize(__sz), but default-initializes the new elements, so that
+  // trivial ones are not written (extension). A sentinel layout derives the
+  // size from the slots' values, so it cannot hold unwritten elements.
+  constexpr void resize_for_overwrite(size_type __sz)
+    requires(default_initializable<__T> &&
+             !__iv_detail::__layout_traits<__Layout, __N>::__has_sentinel)
+  {
+    if (__sz > __N) [[unlikely]]
+      throw bad_alloc{};
+    else if (__sz > size())
+      __construct_back<true>(__sz);
+    else {
+      __unsafe_destroy(begin() + __sz, end());
+      __unsafe_set_size(__sz);
+    }
+  }
+
+  // Modeled on basic_string::resize_and_overwrite (extension): resizes to
+  // __n as resize_for_overwrite does, then calls __op(data(), __n), which
+  // writes the elements in place, e.g. with read(2), and returns how many
+  // of them to keep, at most __n. The elements past those are destroyed.
+  template <class __Operation>
+  constexpr void resize_and_overwrite(size_type __n, __Operation __op)
+    requires(default_initializable<__T>)
+  {
+    if (__n > __N) [[unlikely]]
+      throw bad_alloc{};
+    const size_type __sz = size();
+    if (__n > __sz)
+      __construct_back<true>(__n);
+    else {
+      __unsafe_destroy(data() + __n, data() + __sz);
+      __unsafe_set_size(__n);
+    }
+    const auto __r = static_cast<size_type>(::std::move(__op)(data(), __n));
+    __IV_EXPECT(__r <= __n && "resize_and_overwrite: result past __n");
+    __unsafe_destroy(data() + __r, data() + __n);
+    // __op may have written past the elements it keeps.
+    if constexpr (__fixed_vacant)
+      ::std::fill(const_cast<remove_const_t<__T> *>(data()) + __r,
+                  const_cast<remove_const_t<__T> *>(data()) + __n,
+                  __vacant_value());
+    __unsafe_set_size(__r);
+  }
+
   constexpr reference at(size_type __pos) {
     if (__pos >= size()) [[unlikely]]
       throw out_of_range("inplace_vector::at");
@@ -933,32 +2283,79 @@ public:
     __unsafe_set_size(size() - 1);
   }
 
+  // The copy and move operations are trivial when the corresponding
+  // operations of __T are, which makes inplace_vector trivially copyable (and
+  // the storage copy cheap) for trivially copyable __T.
+  constexpr inplace_vector(const inplace_vector &)
+    requires(is_trivially_copy_constructible_v<__T>)
+  = default;
+  constexpr inplace_vector(inplace_vector &&)
+    requires(is_trivially_move_constructible_v<__T>)
+  = default;
+  constexpr inplace_vector &operator=(const inplace_vector &)
+    requires(is_trivially_destructible_v<__T> &&
+             is_trivially_copy_constructible_v<__T> &&
+             is_trivially_copy_assignable_v<__T>)
+  = default;
+  constexpr inplace_vector &operator=(inplace_vector &&)
+    requires(is_trivially_destructible_v<__T> &&
+             is_trivially_move_constructible_v<__T> &&
+             is_trivially_move_assignable_v<__T>)
+  = default;
+
   constexpr inplace_vector(const inplace_vector &__x)
-    requires(copyable<__T>)
+    requires(!is_trivially_copy_constructible_v<__T> && copyable<__T>)
   {
     for (auto &&__e : __x)
-      emplace_back(__e);
+      unchecked_emplace_back(__e);
   }
-  constexpr inplace_vector(inplace_vector &&__x)
-    requires(movable<__T>)
+  constexpr inplace_vector(inplace_vector &&__x) noexcept(
+      __N == 0 || is_nothrow_move_constructible_v<__T>)
+    requires(!is_trivially_move_constructible_v<__T> && movable<__T>)
   {
+    if constexpr (__iv_detail::__trivially_relocatable<__T>) {
+      if !consteval {
+        // Relocation leaves no live elements in __x, so __x becomes empty.
+        __iv_detail::__relocate(__x.begin(), __x.end(), begin());
+        __unsafe_set_size(__x.size());
+        __x.__unsafe_set_size(0);
+        return;
+      }
+    }
     for (auto &&__e : __x)
-      emplace_back(::std::move(__e));
+      unchecked_emplace_back(::std::move(__e));
   }
   constexpr inplace_vector &operator=(const inplace_vector &__x)
-    requires(copyable<__T>)
+    requires(!(is_trivially_destructible_v<__T> &&
+               is_trivially_copy_constructible_v<__T> &&
+               is_trivially_copy_assignable_v<__T>) &&
+             copyable<__T>)
   {
-    clear();
-    for (auto &&__e : __x)
-      emplace_back(__e);
+    if (this == &__x) [[unlikely]]
+      return *this;
+    __assign_n(__x.size(), __x.begin());
     return *this;
   }
-  constexpr inplace_vector &operator=(inplace_vector &&__x)
-    requires(movable<__T>)
+  constexpr inplace_vector &operator=(inplace_vector &&__x) noexcept(
+      __N == 0 || (is_nothrow_move_assignable_v<__T> &&
+                   is_nothrow_move_constructible_v<__T>))
+    requires(!(is_trivially_destructible_v<__T> &&
+               is_trivially_move_constructible_v<__T> &&
+               is_trivially_move_assignable_v<__T>) &&
+             movable<__T>)
   {
+    if (this == &__x) [[unlikely]]
+      return *this;
     clear();
-    for (auto &&__e : __x)
-      emplace_back(::std::move(__e));
+    if constexpr (__iv_detail::__trivially_relocatable<__T>) {
+      if !consteval {
+        __iv_detail::__relocate(__x.begin(), __x.end(), begin());
+        __unsafe_set_size(__x.size());
+        __x.__unsafe_set_size(0);
+        return *this;
+      }
+    }
+    __assign_n(__x.size(), make_move_iterator(__x.begin()));
     return *this;
   }
 
@@ -967,9 +2364,36 @@ public:
       (is_nothrow_swappable_v<__T> && is_nothrow_move_constructible_v<__T>))
     requires(movable<__T>)
   {
-    auto tmp = ::std::move(__x);
-    __x = ::std::move(*this);
-    (*this) = ::std::move(tmp);
+    if (this == &__x) [[unlikely]]
+      return;
+    const size_type __sz = size();
+    const size_type __x_sz = __x.size();
+    if constexpr (__iv_detail::__trivially_relocatable<__T>) {
+      if !consteval {
+        // Swapping the bytes of relocatable objects swaps their values. Small
+        // storage is swapped whole: the fixed width lets the compiler inline
+        // the copies.
+        constexpr size_t __small_storage_bytes = 256;
+        __iv_detail::__swap_bytes(
+            static_cast<void *>(data()), static_cast<void *>(__x.data()),
+            sizeof(__T) * __N <= __small_storage_bytes
+                ? sizeof(__T) * __N
+                : sizeof(__T) * ::std::max(__sz, __x_sz));
+        __unsafe_set_size(__x_sz);
+        __x.__unsafe_set_size(__sz);
+        return;
+      }
+    }
+    // Swap the common prefix element-wise, then move the rest of the longer
+    // vector's elements over to the shorter one.
+    inplace_vector &__short = __sz < __x_sz ? *this : __x;
+    inplace_vector &__long = __sz < __x_sz ? __x : *this;
+    const size_type __n = __short.size();
+    ::std::swap_ranges(__short.begin(), __short.end(), __long.begin());
+    for (iterator __it = __long.begin() + __n; __it != __long.end(); ++__it)
+      __short.unchecked_emplace_back(::std::move(*__it));
+    __long.__unsafe_destroy(__long.begin() + __n, __long.end());
+    __long.__unsafe_set_size(__n);
   }
 
   template <class __InputIterator>
@@ -977,57 +2401,121 @@ public:
     requires(constructible_from<__T, iter_reference_t<__InputIterator>> &&
              movable<__T>)
   {
-    clear();
-    insert(begin(), __first, __last);
+    if constexpr (forward_iterator<__InputIterator>) {
+      __assign_n(static_cast<size_type>(distance(__first, __last)), __first);
+    } else {
+      iterator __it = begin();
+      for (; __it != end() && __first != __last; ++__it, ++__first)
+        __iv_detail::__assign_from(*__it, *__first);
+      erase(__it, end());
+      for (; __first != __last; ++__first)
+        emplace_back(*__first);
+    }
   }
   template <__iv_detail::__container_compatible_range<__T> __R>
   constexpr void assign_range(__R &&__rg)
     requires(constructible_from<__T, ranges::range_reference_t<__R>> &&
              movable<__T>)
   {
-    assign(begin(__rg), end(__rg));
+    assign(ranges::begin(__rg), ranges::end(__rg));
   }
   constexpr void assign(size_type __n, const __T &__u)
     requires(constructible_from<__T, const __T &> && movable<__T>)
   {
-    clear();
-    insert(begin(), __n, __u);
+    // Assigning from an element of *this is fine: it is only ever assigned
+    // its own value, and it is destroyed last if it is past __n.
+    __assign_n(__n, __iv_detail::__repeat_iterator<__T>{addressof(__u)});
   }
   constexpr void assign(initializer_list<__T> __il)
     requires(constructible_from<
                  __T, ranges::range_reference_t<initializer_list<__T>>> &&
              movable<__T>)
   {
-    clear();
-    insert_range(begin(), __il);
-  }
-
-  constexpr friend int /*synth-three-way-result<T>*/
-  operator<=>(const inplace_vector & __x, const inplace_vector & __y) {
-    if (__x.size() < __y.size())
-      return -1;
-    if (__x.size() > __y.size())
-      return +1;
-
-    bool __all_equal = true;
-    bool __all_less = true;
-    for (size_type __i = 0; __i < __x.size(); ++__i) {
-      if (__x[__i] < __y[__i])
-        __all_equal = false;
-      if (__x[__i] == __y[__i])
-        __all_less = false;
-    }
-
-    if (__all_equal)
-      return 0;
-    if (__all_less)
-      return -1;
-    return 1;
+    __assign_n(__il.size(), __il.begin());
   }
 };
 
+// [inplace.vector.erasure]
+// Removes the matching elements in one pass that packs the others to the
+// front, then destroys the vacated tail once. Arithmetic elements are packed
+// without branching on the predicate.
+template <class __T, size_t __N, class __L, class __Predicate>
+constexpr typename inplace_vector<__T, __N, __L>::size_type
+erase_if(inplace_vector<__T, __N, __L> &__c, __Predicate __pred)
+  requires(movable<__T>)
+{
+  using __size_type = typename inplace_vector<__T, __N, __L>::size_type;
+  const auto __n = __c.size();
+  if constexpr (is_arithmetic_v<__T>) {
+    auto __keep = [&__pred](const __T &__e) { return !__pred(__e); };
+    const size_t __kept =
+        __iv_detail::__compact<__N>(__c.data(), __n, __c.data(), __keep);
+    __c.erase(__c.begin() + __kept, __c.end());
+    return static_cast<__size_type>(__n - __kept);
+  } else {
+    __c.erase(::std::remove_if(__c.begin(), __c.end(), ::std::ref(__pred)),
+              __c.end());
+    return static_cast<__size_type>(__n - __c.size());
+  }
+}
+
+template <class __T, size_t __N, class __L, class __U = __T>
+constexpr typename inplace_vector<__T, __N, __L>::size_type
+erase(inplace_vector<__T, __N, __L> &__c, const __U &__value)
+  requires(movable<__T>)
+{
+  return erase_if(__c, [&__value](const __T &__e) { return __e == __value; });
+}
+
+namespace __iv_detail {
+// The largest capacity __C for which inplace_vector<__T, __C, __L> fits in
+// __Bytes, searching down from the capacity the elements alone would allow.
+template <class __T, size_t __Bytes, class __L,
+          size_t __C = __Bytes / sizeof(__T)>
+consteval size_t __capacity_for_bytes() {
+  if constexpr (__C == 0 || sizeof(inplace_vector<__T, __C, __L>) <= __Bytes)
+    return __C;
+  else
+    return __capacity_for_bytes<__T, __Bytes, __L, __C - 1>();
+}
+} // namespace __iv_detail
+
+/// The inplace_vector with the largest capacity whose object fits in
+/// __Bytes, e.g. `inplace_vector_for_bytes<float, 128, iv_layout::align<64>>`
+/// for a vector that occupies exactly two cache lines.
+template <class __T, size_t __Bytes, class __Layout = iv_layout::options<>>
+using inplace_vector_for_bytes = inplace_vector<
+    __T, __iv_detail::__capacity_for_bytes<__T, __Bytes, __Layout>(),
+    __Layout>;
+
 } // namespace beman
 
+/// Hashes the elements in order. Elements whose object representation is
+/// unique, so that equal values have equal bytes, are hashed as one byte
+/// string, whose length covers size(); others combine their own hashes.
+template <class __T, ::std::size_t __N, class __Layout>
+  requires requires(const __T &__t) {
+    { ::std::hash<::std::remove_const_t<__T>>{}(__t) }
+        -> ::std::convertible_to<::std::size_t>;
+  }
+struct std::hash<beman::inplace_vector<__T, __N, __Layout>> {
+  ::std::size_t
+  operator()(const beman::inplace_vector<__T, __N, __Layout> &__v) const {
+    if constexpr (::std::has_unique_object_representations_v<__T>) {
+      return ::std::hash<::std::string_view>{}(::std::string_view(
+          reinterpret_cast<const char *>(__v.data()), __v.size() * sizeof(__T)));
+    } else {
+      // boost::hash_combine, seeded with the size.
+      ::std::size_t __seed = __v.size();
+      for (const __T &__e : __v)
+        __seed ^= ::std::hash<::std::remove_const_t<__T>>{}(__e) +
+                  static_cast<::std::size_t>(0x9e3779b97f4a7c15ull) +
+                  (__seed << 6) + (__seed >> 2);
+      return __seed;
+    }
+  }
+};
+
 // undefine all the internal macros
 #undef __IV_ASSUME
 #undef __IV_ASSERT
@@ -17,9 +17,20 @@
 
 #include <beman/inplace_vector/inplace_vector.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <compare>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <list>
 #include <memory>
+#include <random>
+#include <ranges>
+#include <span>
+#include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #define CHECK(...)                                                             \
@@ -52,8 +63,21 @@ template struct beman::__iv_detail::__storage::__trivial<int, 10>;
 template struct beman::__iv_detail::__storage::__non_trivial<
     std::unique_ptr<int>, 10>;
 
+// A trivially copyable element that is not trivial:
+struct message {
+  int id = -1;
+  double payload = 0.0;
+  constexpr bool operator==(const message &) const = default;
+};
+static_assert(std::is_trivially_copyable_v<message> &&
+              !std::is_trivial_v<message>);
+template struct beman::__iv_detail::__storage::__trivially_copyable<message,
+                                                                    10>;
+
 template struct beman::__iv_detail::__storage::__zero_sized<const int>;
 template struct beman::__iv_detail::__storage::__trivial<const int, 10>;
+template struct beman::__iv_detail::__storage::__trivially_copyable<
+    const message, 10>;
 template struct beman::__iv_detail::__storage::__non_trivial<
     const std::unique_ptr<int>, 10>;
 
@@ -65,6 +89,10 @@ template struct beman::inplace_vector<int, 1>;
 template struct beman::inplace_vector<int, 2>;
 template struct beman::inplace_vector<const int, 3>;
 
+// trivially copyable non-empty:
+template struct beman::inplace_vector<message, 3>;
+template struct beman::inplace_vector<const message, 3>;
+
 // non-trivial
 template struct beman::inplace_vector<std::string, 3>;
 template struct beman::inplace_vector<const std::string, 3>;
@@ -73,6 +101,170 @@ template struct beman::inplace_vector<const std::string, 3>;
 template struct beman::inplace_vector<std::unique_ptr<int>, 3>;
 template struct beman::inplace_vector<const std::unique_ptr<int>, 3>;
 
+// sizeof regression table:
+static_assert(sizeof(beman::inplace_vector<int, 0>) == 1);
+static_assert(sizeof(beman::inplace_vector<char, 1>) == 2);
+static_assert(sizeof(beman::inplace_vector<char, 100>) == 101);
+static_assert(sizeof(beman::inplace_vector<int, 1>) == 8);
+static_assert(sizeof(beman::inplace_vector<int, 10>) == 44);
+static_assert(sizeof(beman::inplace_vector<int, 1000>) == 4004);
+static_assert(sizeof(beman::inplace_vector<std::uint64_t, 3>) == 32);
+static_assert(sizeof(beman::inplace_vector<std::uint64_t, 1000>) == 8008);
+static_assert(sizeof(beman::inplace_vector<char, 100,
+                                           beman::iv_layout::size_first>) ==
+              101);
+static_assert(sizeof(beman::inplace_vector<std::uint64_t, 3,
+                                           beman::iv_layout::size_first>) ==
+              32);
+static_assert(
+    sizeof(beman::inplace_vector<
+           int, 1000, beman::iv_layout::options<beman::iv_layout::size_first>>) ==
+    4004);
+// The size type widens only once the capacity no longer fits:
+static_assert(sizeof(beman::inplace_vector<char, 255>) == 256);
+static_assert(sizeof(beman::inplace_vector<char, 256>) == 258);
+static_assert(sizeof(beman::inplace_vector<char, 65535>) == 65538);
+static_assert(sizeof(beman::inplace_vector<char, 65536>) == 65540);
+static_assert(sizeof(beman::inplace_vector<char, 4294967295>) == 4294967300);
+static_assert(sizeof(beman::inplace_vector<char, 4294967296>) == 4294967304);
+static_assert(sizeof(beman::inplace_vector<std::string, 255>) ==
+              255 * sizeof(std::string) + alignof(std::string));
+// A user-selected size type:
+static_assert(
+    sizeof(beman::inplace_vector<char, 100,
+                                 beman::iv_layout::stored_size<std::uint32_t>>) ==
+    104);
+static_assert(
+    sizeof(beman::inplace_vector<
+           char, 100,
+           beman::iv_layout::options<beman::iv_layout::size_first,
+                                     beman::iv_layout::stored_size<std::uint16_t>>>) ==
+    102);
+static_assert(
+    std::is_same_v<beman::inplace_vector<
+                       int, 4, beman::iv_layout::stored_size<std::uint64_t>>::size_type,
+                   std::size_t>);
+// Over-aligned storage:
+static_assert(alignof(beman::inplace_vector<float, 16,
+                                            beman::iv_layout::align<64>>) == 64);
+static_assert(sizeof(beman::inplace_vector<float, 16,
+                                           beman::iv_layout::align<64>>) == 128);
+static_assert(sizeof(beman::inplace_vector<
+                     float, 16,
+                     beman::iv_layout::options<beman::iv_layout::size_first,
+                                               beman::iv_layout::align<64>>>) ==
+              128);
+static_assert(alignof(beman::inplace_vector<std::string, 2,
+                                            beman::iv_layout::align<64>>) == 64);
+// An alignment below the element's has no effect:
+static_assert(sizeof(beman::inplace_vector<std::uint64_t, 3,
+                                           beman::iv_layout::align<2>>) == 32);
+// Capacity derived from a byte budget:
+static_assert(beman::inplace_vector_for_bytes<int, 64>::capacity() == 15);
+static_assert(sizeof(beman::inplace_vector_for_bytes<int, 64>) == 64);
+static_assert(beman::inplace_vector_for_bytes<char, 256>::capacity() == 255);
+static_assert(
+    beman::inplace_vector_for_bytes<float, 128,
+                                    beman::iv_layout::align<64>>::capacity() ==
+    31);
+static_assert(
+    sizeof(beman::inplace_vector_for_bytes<float, 128,
+                                           beman::iv_layout::align<64>>) == 128);
+static_assert(beman::inplace_vector_for_bytes<std::uint64_t, 8>::capacity() ==
+              0);
+// Storage padded to a SIMD register width:
+static_assert(beman::inplace_vector<float, 50>::padded_capacity() == 50);
+static_assert(beman::inplace_vector<float, 50, beman::iv_layout::pad_to<32>>::
+                  padded_capacity() == 56);
+static_assert(beman::inplace_vector<float, 50, beman::iv_layout::pad_to<32>>::
+                  capacity() == 50);
+static_assert(sizeof(beman::inplace_vector<float, 50,
+                                           beman::iv_layout::pad_to<32>>) ==
+              56 * sizeof(float) + sizeof(float));
+static_assert(beman::inplace_vector<double, 8, beman::iv_layout::pad_to<64>>::
+                  padded_capacity() == 8);
+static_assert(
+    beman::inplace_vector<std::string, 3>::padded_capacity() == 3);
+// Size implied by a sentinel value:
+enum class hop : std::uint8_t { a, b, c, none = 0xff };
+static_assert(sizeof(beman::inplace_vector<int *, 4,
+                                           beman::iv_layout::sentinel<nullptr>>) ==
+              4 * sizeof(int *));
+static_assert(
+    sizeof(beman::inplace_vector<hop, 7, beman::iv_layout::sentinel<hop::none>>) ==
+    7);
+static_assert(std::is_trivially_copyable_v<
+              beman::inplace_vector<int *, 4, beman::iv_layout::sentinel<nullptr>>>);
+template struct beman::inplace_vector<hop, 5,
+                                      beman::iv_layout::sentinel<hop::none>>;
+
+// Special members are trivial when the element's are:
+static_assert(std::is_trivially_copyable_v<beman::inplace_vector<int, 0>>);
+static_assert(std::is_trivially_copyable_v<beman::inplace_vector<int, 8>>);
+static_assert(std::is_trivially_destructible_v<beman::inplace_vector<int, 8>>);
+static_assert(
+    std::is_trivially_copy_constructible_v<beman::inplace_vector<int, 8>>);
+static_assert(
+    std::is_trivially_move_constructible_v<beman::inplace_vector<int, 8>>);
+static_assert(
+    std::is_trivially_copy_assignable_v<beman::inplace_vector<int, 8>>);
+static_assert(
+    std::is_trivially_move_assignable_v<beman::inplace_vector<int, 8>>);
+static_assert(
+    !std::is_trivially_copyable_v<beman::inplace_vector<std::string, 8>>);
+static_assert(
+    !std::is_trivially_destructible_v<beman::inplace_vector<std::string, 8>>);
+static_assert(!std::is_trivially_destructible_v<
+              beman::inplace_vector<std::unique_ptr<int>, 8>>);
+static_assert(!std::is_copy_constructible_v<
+              beman::inplace_vector<std::unique_ptr<int>, 8>>);
+static_assert(std::is_trivially_copyable_v<beman::inplace_vector<message, 8>>);
+static_assert(
+    std::is_trivially_destructible_v<beman::inplace_vector<message, 8>>);
+static_assert(sizeof(beman::inplace_vector<message, 4>) ==
+              4 * sizeof(message) + alignof(message));
+
+// Moves are noexcept when the element's are, so that e.g. std::vector moves
+// instead of copying on reallocation:
+static_assert(
+    std::is_nothrow_move_constructible_v<beman::inplace_vector<int, 8>>);
+static_assert(
+    std::is_nothrow_move_constructible_v<beman::inplace_vector<std::string, 8>>);
+static_assert(
+    std::is_nothrow_move_assignable_v<beman::inplace_vector<std::string, 8>>);
+static_assert(std::is_nothrow_move_constructible_v<
+              beman::inplace_vector<std::unique_ptr<int>, 8>>);
+
+struct throwing_move {
+  throwing_move() = default;
+  throwing_move(throwing_move const &) = default;
+  throwing_move(throwing_move &&) noexcept(false) {}
+  throwing_move &operator=(throwing_move const &) = default;
+  throwing_move &operator=(throwing_move &&) noexcept(false) { return *this; }
+};
+static_assert(!std::is_nothrow_move_constructible_v<
+              beman::inplace_vector<throwing_move, 8>>);
+static_assert(
+    !std::is_nothrow_move_assignable_v<beman::inplace_vector<throwing_move, 8>>);
+static_assert(
+    std::is_nothrow_move_constructible_v<beman::inplace_vector<throwing_move, 0>>);
+
+// A type that opts into trivial relocation.
+struct relocatable {
+  std::unique_ptr<int> p;
+  relocatable() = default;
+  explicit relocatable(int i) : p(std::make_unique<int>(i)) {
+    if (i < 0)
+      throw std::invalid_argument("negative");
+  }
+  int value() const { return p ? *p : -1; }
+};
+template <>
+inline constexpr bool beman::enable_trivially_relocatable<relocatable> = true;
+
+static_assert(beman::enable_trivially_relocatable<int>);
+static_assert(!beman::enable_trivially_relocatable<std::string>);
+
 struct tint {
   std::size_t i;
   tint() = default;
@@ -416,6 +608,65 @@ int main() {
     static_assert(a.capacity() == std::size_t(10));
   }
 
+  { // resize_for_overwrite and resize_and_overwrite
+    vector<int, 10> a = {1, 2, 3};
+    a.resize_for_overwrite(8);
+    CHECK(a.size() == 8 && a[0] == 1 && a[2] == 3);
+    a.resize_for_overwrite(2);
+    CHECK(a == (vector<int, 10>{1, 2}));
+    CHECK_THROWS(a.resize_for_overwrite(11), std::bad_alloc);
+
+    struct defaulted {
+      int x = 7;
+    };
+    vector<defaulted, 4> d;
+    d.resize_for_overwrite(3);
+    CHECK(d.size() == 3 && d[2].x == 7);
+
+    vector<std::byte, 9000> packet;
+    packet.resize_and_overwrite(9000, [](std::byte *p, std::size_t n) {
+      CHECK(n == 9000);
+      std::memcpy(p, "hello", 5);
+      return 5;
+    });
+    CHECK(packet.size() == 5 && packet[4] == std::byte{'o'});
+    packet.resize_and_overwrite(2,
+                                [](std::byte *, std::size_t n) { return n; });
+    CHECK(packet.size() == 2 && packet[1] == std::byte{'e'});
+
+    vector<std::string, 4> s = {"a", "b"};
+    s.resize_and_overwrite(4, [](std::string *p, std::size_t) {
+      p[2].push_back('c');
+      return 3;
+    });
+    CHECK(s == (vector<std::string, 4>{"a", "b", "c"}));
+
+    beman::inplace_vector<hop, 5, beman::iv_layout::sentinel<hop::none>> h;
+    h.resize_and_overwrite(5, [](hop *p, std::size_t) {
+      p[0] = hop::a;
+      p[1] = p[2] = hop::c; // past the result
+      return 1;
+    });
+    CHECK(h.size() == 1 && h[0] == hop::a);
+    beman::inplace_vector<int, 8, beman::iv_layout::pad_to<64>> padded;
+    padded.resize_and_overwrite(8, [](int *p, std::size_t n) {
+      std::fill(p, p + n, 1);
+      return 3;
+    });
+    CHECK(padded.size() == 3 && padded.sum() == 3);
+
+    static_assert([] {
+      vector<int, 8> c;
+      c.resize_and_overwrite(6, [](int *p, std::size_t n) {
+        for (std::size_t i = 0; i != n; ++i)
+          p[i] = static_cast<int>(i);
+        return 4;
+      });
+      c.resize_for_overwrite(5);
+      return c.size() == 5 && c[3] == 3;
+    }());
+  }
+
   { // resize value:
     using Copyable = int;
     vector<Copyable, 10> a(std::size_t(10));
@@ -466,6 +717,36 @@ int main() {
     CHECK(std::equal(std::begin(a), std::end(a), std::begin(b), std::end(b)));
   }
 
+  { // assignment reuses the resources of existing elements
+    using S = std::string;
+    using vec_t = vector<S, 4>;
+    vec_t a = {S(100, 'a'), S(100, 'b'), S(100, 'c')};
+    char const *buffer = a[0].data();
+    vec_t const b = {S(50, 'x'), S(50, 'y')};
+    a = b;
+    CHECK(a == b);
+    CHECK(a[0].data() == buffer);
+    a.assign(4, S(10, 'z'));
+    CHECK(a == vec_t(4, S(10, 'z')));
+    CHECK(a[0].data() == buffer);
+    a.assign({"p", "q"});
+    CHECK(a == vec_t{"p", "q"});
+    CHECK(a[0].data() == buffer);
+    a.assign(3, a[1]); // aliasing an element
+    CHECK(a == vec_t(3, "q"));
+    std::vector<S> const r = {"r", "s", "t", "u"};
+    a.assign_range(r);
+    CHECK(a == vec_t(r.begin(), r.end()));
+    vec_t m(2, "m");
+    a = std::move(m);
+    CHECK(a == vec_t(2, "m"));
+    std::istringstream in("i j k");
+    a.assign(std::istream_iterator<S>(in), std::istream_iterator<S>());
+    CHECK(a == vec_t{"i", "j", "k"});
+    CHECK_THROWS(a.assign(5, S()), std::bad_alloc);
+    CHECK(a == vec_t{"i", "j", "k"});
+  }
+
   { // copy construct
     vector<int, 3> a = {0, 1, 2};
     CHECK(a.size() == std::size_t{3});
@@ -495,6 +776,75 @@ int main() {
     CHECK(a.size() == std::size_t{3});
   }
 
+  { // destructor of non-trivially destructible elements
+    struct counted {
+      int *live;
+      explicit counted(int *l) : live(l) { ++*live; }
+      counted(counted const &o) : live(o.live) { ++*live; }
+      counted &operator=(counted const &) = default;
+      ~counted() { --*live; }
+    };
+    int live = 0;
+    {
+      vector<counted, 5> a;
+      a.emplace_back(&live);
+      a.emplace_back(&live);
+      vector<counted, 5> b(a);
+      CHECK(live == 4);
+      b.pop_back();
+      CHECK(live == 3);
+    }
+    CHECK(live == 0);
+  }
+
+  { // layout: size placement
+    auto data_offset = [](auto const &v) {
+      return reinterpret_cast<char const *>(v.data()) -
+             reinterpret_cast<char const *>(&v);
+    };
+    vector<std::uint64_t, 3> after = {1, 2};
+    beman::inplace_vector<std::uint64_t, 3, beman::iv_layout::size_first>
+        first = {1, 2};
+    CHECK(data_offset(after) == 0);
+    CHECK(data_offset(first) == alignof(std::uint64_t));
+    CHECK(std::equal(after.begin(), after.end(), first.begin(), first.end()));
+    first.push_back(3);
+    first.erase(first.begin());
+    CHECK(first.size() == 2 && first[0] == 2 && first[1] == 3);
+#if defined(__GNUC__) && !defined(_WIN32)
+    // Itanium C++ ABI: the padding after the size can be reused.
+    struct tagged {
+      [[no_unique_address]] vector<std::uint64_t, 2> v;
+      char tag;
+    };
+    static_assert(sizeof(tagged) == sizeof(vector<std::uint64_t, 2>));
+#endif
+  }
+
+  { // copy and move of trivially copyable elements
+    // Small capacity: the whole storage is copied in a fixed-width copy.
+    vector<int, 4> a = {0, 1};
+    vector<int, 4> b(a);
+    CHECK(b.size() == 2 && b[0] == 0 && b[1] == 1);
+    vector<int, 4> c = {7, 7, 7, 7};
+    c = a;
+    CHECK(c == a);
+    c = std::move(b);
+    CHECK(c == a);
+    c = c;
+    CHECK(c == a);
+
+    // Large capacity: only size() elements are copied.
+    vector<std::uint64_t, 64> d(10, 3);
+    vector<std::uint64_t, 64> e(d);
+    CHECK(e == d);
+    vector<std::uint64_t, 64> f(60, 9);
+    f = e;
+    CHECK(f.size() == 10 && f == d);
+    vector<std::uint64_t, 64> g(std::move(f));
+    CHECK(g == d);
+  }
+
   { // old tests
     using vec_t = vector<int, 5>;
     vec_t vec1(5);
@@ -676,6 +1026,391 @@ int main() {
     }
   }
 
+  { // swap: non-trivial elements of different sizes
+    using C = vector<std::string, 5>;
+    C c0 = {"a", "b"};
+    C c1 = {"c", "d", "e", "f"};
+    c0.swap(c1);
+    CHECK(c0 == C{"c", "d", "e", "f"});
+    CHECK(c1 == C{"a", "b"});
+    swap(c0, c1);
+    CHECK(c0 == C{"a", "b"});
+    CHECK(c1 == C{"c", "d", "e", "f"});
+    C c2;
+    c2.swap(c1);
+    CHECK(c1.empty());
+    CHECK(c2 == C{"c", "d", "e", "f"});
+    c2.swap(c2);
+    CHECK(c2 == C{"c", "d", "e", "f"});
+  }
+
+  { // comparison: lexicographic, for each element kind
+    using bytes = vector<std::uint8_t, 32>;
+    CHECK(bytes{1, 2, 3} == bytes{1, 2, 3});
+    CHECK(bytes{1, 2, 3} != bytes{1, 2});
+    CHECK(bytes{} == bytes{});
+    CHECK((bytes{1, 2} <=> bytes{1, 2, 0}) == std::strong_ordering::less);
+    CHECK((bytes{2} <=> bytes{1, 9, 9}) == std::strong_ordering::greater);
+    CHECK((bytes{0x80} <=> bytes{0x7f}) == std::strong_ordering::greater);
+    CHECK((bytes{} <=> bytes{}) == std::strong_ordering::equal);
+
+    using ints = vector<int, 8>;
+    CHECK(ints{-1, 5} < ints{0});
+    CHECK(ints{1, 2} < ints{1, 2, 3});
+    CHECK(ints{1, 2} == ints{1, 2});
+    CHECK((ints{3, -1} <=> ints{3, 1}) == std::strong_ordering::less);
+
+    using doubles = vector<double, 4>;
+    CHECK((doubles{0.0} == doubles{-0.0}));
+    CHECK(!(doubles{NAN} == doubles{NAN}));
+    CHECK((doubles{1.0, NAN} <=> doubles{2.0}) == std::partial_ordering::less);
+    CHECK((doubles{NAN} <=> doubles{1.0}) == std::partial_ordering::unordered);
+
+    using strings = vector<std::string, 4>;
+    CHECK(strings{"a", "b"} < strings{"b"});
+    CHECK(strings{"a"} < strings{"a", ""});
+
+    // Only operator< available: weak ordering.
+    struct less_only {
+      int i;
+      bool operator<(const less_only &o) const { return i < o.i; }
+    };
+    using lo = vector<less_only, 3>;
+    static_assert(std::is_same_v<decltype(lo{} <=> lo{}), std::weak_ordering>);
+    CHECK((lo{{1}, {2}} <=> lo{{1}, {3}}) == std::weak_ordering::less);
+    CHECK((lo{{1}} <=> lo{{1}}) == std::weak_ordering::equivalent);
+
+    static_assert([] {
+      bytes a = {1, 2, 3}, b = {1, 2, 4};
+      return a < b && a == a && !(a == b) && bytes{} < a;
+    }());
+  }
+
+  { // search and reduction over arithmetic elements
+    vector<int, 64> v;
+    CHECK(v.index_of(1) == 0 && !v.contains(1) && v.count(1) == 0);
+    CHECK(v.sum() == 0 && v.find(1) == v.end());
+    for (int i = 0; i < 50; ++i)
+      v.push_back(i % 7);
+    CHECK(v.index_of(3) == 3 && v.index_of(9) == 50);
+    CHECK(v.find(6) == v.begin() + 6);
+    CHECK(v.contains(0) && !v.contains(-1));
+    CHECK(v.count(0) == 8 && v.count(6) == 7);
+    CHECK(v.sum() == 147);
+    CHECK(v.min() == 0 && v.max() == 6);
+    v[41] = -5;
+    v[49] = 99;
+    auto [lo, hi] = v.minmax();
+    CHECK(lo == -5 && hi == 99);
+    CHECK(v.index_of(99) == 49);
+    const vector<std::int8_t, 40> c(33, std::int8_t{1});
+    CHECK(c.count(1) == 33 && c.find(1) == c.begin() && c.min() == 1);
+
+    // The zeroed padding must not be found.
+    beman::inplace_vector<float, 50, beman::iv_layout::pad_to<32>> f = {
+        1.f, 2.f, 3.f};
+    CHECK(f.index_of(0.f) == 3 && f.index_of(3.f) == 2);
+    CHECK(f.sum() == 6.f && f.count(0.f) == 0);
+    CHECK((vector<double, 3>{2.0, -1.0}.minmax().min == -1.0));
+
+    static_assert([] {
+      vector<unsigned, 40> v;
+      for (unsigned i = 0; i < 37; ++i)
+        v.push_back(i);
+      return v.sum() == 666 && v.index_of(36) == 36 && v.count(5) == 1 &&
+             v.max() == 36 && v.min() == 0 && !v.contains(37);
+    }());
+  }
+
+  { // sort and stable_sort
+    // Every size up to the capacity, against std::sort.
+    auto check_sorts = []<class T, std::size_t N>(vector<T, N> v) {
+      for (std::size_t n = 0; n <= N; ++n) {
+        vector<T, N> a(v.begin(), v.begin() + n);
+        std::vector<T> expected(a.begin(), a.end());
+        std::sort(expected.begin(), expected.end());
+        vector<T, N> b = a;
+        a.sort();
+        b.stable_sort();
+        CHECK(std::ranges::equal(a, expected));
+        CHECK(std::ranges::equal(b, expected));
+      }
+    };
+    vector<std::uint32_t, 16> u;
+    for (std::uint32_t i = 0; i < 16; ++i)
+      u.push_back((i * 2654435761u) % 97);
+    check_sorts(u);
+    vector<int, 32> i32;
+    for (int i = 0; i < 32; ++i)
+      i32.push_back((i * 37) % 11 - 5);
+    check_sorts(i32);
+    vector<double, 7> d = {3.5, -1.0, 1e300, -INFINITY, 0.0, INFINITY, 2.0};
+    check_sorts(d);
+    vector<unsigned char, 5> b = {255, 0, 7, 255, 1};
+    check_sorts(b);
+    vector<int, 100> big;
+    for (int i = 0; i < 100; ++i)
+      big.push_back((i * 53) % 100);
+    big.sort(std::greater<>{});
+    CHECK(big.front() == 99 && big.back() == 0 &&
+          std::ranges::is_sorted(big, std::greater<>{}));
+
+    // Stability, with a comparator the network does not apply to.
+    vector<std::pair<int, int>, 8> p = {{2, 0}, {1, 1}, {2, 2}, {1, 3}, {0, 4}};
+    p.stable_sort([](auto &x, auto &y) { return x.first < y.first; });
+    CHECK(p == (vector<std::pair<int, int>, 8>{
+                   {0, 4}, {1, 1}, {1, 3}, {2, 0}, {2, 2}}));
+    vector<std::string, 40> strs = {"d", "a", "c", "b"};
+    strs.sort();
+    CHECK(strs == (vector<std::string, 40>{"a", "b", "c", "d"}));
+
+    static_assert([] {
+      vector<int, 12> v = {5, -3, 9, 0, 9, 1, -7, 4, 2};
+      v.sort();
+      vector<int, 12> w = {3, 1, 2};
+      w.stable_sort(std::greater<>{});
+      return v == vector<int, 12>{-7, -3, 0, 1, 2, 4, 5, 9, 9} &&
+             w == vector<int, 12>{3, 2, 1};
+    }());
+  }
+
+  { // radix_sort
+    std::mt19937_64 rng(7);
+    auto check_radix = [&]<class T, std::size_t N>(vector<T, N> v) {
+      std::vector<T> expected(v.begin(), v.end());
+      std::sort(expected.begin(), expected.end());
+      v.radix_sort();
+      CHECK(std::ranges::equal(v, expected));
+    };
+    for (std::size_t n : {0, 1, 63, 64, 65, 4096}) {
+      vector<std::uint32_t, 4096> u;
+      vector<std::int64_t, 4096> i;
+      vector<double, 4096> d;
+      for (std::size_t k = 0; k < n; ++k) {
+        u.push_back(static_cast<std::uint32_t>(rng()));
+        i.push_back(static_cast<std::int64_t>(rng()) >> (k % 40));
+        d.push_back(static_cast<double>(static_cast<std::int64_t>(rng())) /
+                    1e6);
+      }
+      check_radix(u);
+      check_radix(i);
+      check_radix(d);
+    }
+    // Skipped passes: only the low byte differs.
+    vector<std::uint16_t, 200> low;
+    for (int k = 0; k < 200; ++k)
+      low.push_back(static_cast<std::uint16_t>(0x4200 + (k * 89) % 256));
+    check_radix(low);
+
+    // Floating-point keys: -0.0 before 0.0, NaNs at the ends.
+    vector<float, 100> f;
+    for (int k = 0; k < 96; ++k)
+      f.push_back(static_cast<float>((k * 37) % 96) - 48.f);
+    f.push_back(-0.f);
+    f.push_back(INFINITY);
+    f.push_back(-INFINITY);
+    f.push_back(NAN);
+    f.radix_sort();
+    CHECK(f.front() == -INFINITY && std::isnan(f.back()) &&
+          f[f.size() - 2] == INFINITY);
+    CHECK(std::is_sorted(f.begin(), f.end() - 1));
+    auto z = std::find(f.begin(), f.end(), 0.f);
+    CHECK(std::signbit(*z) && *(z + 1) == 0.f && !std::signbit(*(z + 1)));
+
+    // Key extraction; the sort is stable.
+    struct event {
+      std::int32_t time;
+      int seq;
+    };
+    vector<event, 1000> e;
+    for (int k = 0; k < 1000; ++k)
+      e.push_back({(k * 7919) % 100 - 50, k});
+    e.radix_sort(&event::time);
+    CHECK(std::ranges::is_sorted(e, {}, &event::time));
+    CHECK(std::ranges::adjacent_find(e, [](auto &a, auto &b) {
+            return a.time == b.time && a.seq > b.seq;
+          }) == e.end());
+
+    static_assert([] {
+      vector<int, 80> v;
+      for (int k = 0; k < 80; ++k)
+        v.push_back((k * 31) % 80 - 40);
+      v.radix_sort();
+      return std::ranges::is_sorted(v) && v.front() == -40;
+    }());
+  }
+
+  { // hash
+    using keys = vector<std::uint32_t, 16>;
+    std::hash<keys> h;
+    CHECK(h(keys{1, 2, 3}) == h(keys{1, 2, 3}));
+    CHECK(h(keys{1, 2, 3}) != h(keys{1, 2}));
+    CHECK(h(keys{}) == h(keys{}));
+    keys k = {1, 2, 3, 4};
+    k.pop_back();
+    CHECK(h(k) == h(keys{1, 2, 3}));
+
+    using doubles = vector<double, 4>;
+    CHECK(std::hash<doubles>{}(doubles{0.0}) ==
+          std::hash<doubles>{}(doubles{-0.0}));
+    using strings = vector<std::string, 4>;
+    CHECK(std::hash<strings>{}(strings{"ab", "c"}) ==
+          std::hash<strings>{}(strings{"ab", "c"}));
+
+    std::unordered_set<keys> set = {{1, 2}, {1, 2}, {2, 1}, {}};
+    CHECK(set.size() == 3 && set.contains(keys{2, 1}));
+
+    static_assert(
+        std::is_default_constructible_v<std::hash<vector<const int, 2>>>);
+    static_assert(
+        !std::is_default_constructible_v<std::hash<vector<non_copyable, 2>>>);
+  }
+
+  { // swap: constant evaluation
+    static_assert([] {
+      vector<int, 5> c0 = {1, 2, 3};
+      vector<int, 5> c1 = {4};
+      c0.swap(c1);
+      return c0 == vector<int, 5>{4} && c1 == vector<int, 5>{1, 2, 3};
+    }());
+  }
+
+  { // padded storage: the slots past size() stay zero
+    using padded =
+        beman::inplace_vector<float, 50,
+                              beman::iv_layout::options<
+                                  beman::iv_layout::pad_to<32>,
+                                  beman::iv_layout::align<32>>>;
+    // Sums whole 8-lane blocks, with no tail loop.
+    auto block_sum = [](const padded &v) {
+      float lanes[8] = {};
+      for (std::size_t i = 0; i != padded::padded_capacity(); i += 8)
+        for (std::size_t j = 0; j != 8; ++j)
+          lanes[j] += v.data()[i + j];
+      float s = 0;
+      for (float l : lanes)
+        s += l;
+      return s;
+    };
+    auto tail_is_zero = [](const padded &v) {
+      for (std::size_t i = v.size(); i != padded::padded_capacity(); ++i)
+        if (v.data()[i] != 0.f)
+          return false;
+      return true;
+    };
+    padded v;
+    CHECK(reinterpret_cast<std::uintptr_t>(v.data()) % 32 == 0);
+    CHECK(tail_is_zero(v));
+    for (int i = 1; i <= 50; ++i)
+      v.push_back(float(i));
+    CHECK(block_sum(v) == 1275.f);
+    v.pop_back();
+    v.erase(v.begin(), v.begin() + 4);
+    CHECK(tail_is_zero(v));
+    CHECK(block_sum(v) == 1275.f - 50.f - 10.f);
+    v.resize(20);
+    CHECK(tail_is_zero(v));
+    padded w = {1.f, 2.f};
+    v.swap(w);
+    CHECK(tail_is_zero(v) && tail_is_zero(w));
+    CHECK(block_sum(v) == 3.f && w.size() == 20);
+    v = w;
+    v.assign(3, 1.f);
+    CHECK(tail_is_zero(v) && block_sum(v) == 3.f);
+    v.clear();
+    CHECK(tail_is_zero(v) && block_sum(v) == 0.f);
+    static_assert([] {
+      padded v = {1.f, 2.f, 3.f};
+      v.erase(v.begin());
+      return v.data()[2] == 0.f && v.data()[55] == 0.f;
+    }());
+  }
+
+  { // sentinel layout: the size is the number of non-sentinel slots
+    using route = beman::inplace_vector<int *, 4,
+                                        beman::iv_layout::sentinel<nullptr>>;
+    int x[4] = {};
+    route r;
+    CHECK(r.empty());
+    r.push_back(&x[0]);
+    r.push_back(&x[2]);
+    CHECK(r.size() == 2 && r[1] == &x[2]);
+    r.insert(r.begin() + 1, &x[1]);
+    CHECK(r == (route{&x[0], &x[1], &x[2]}));
+    r.push_back(&x[3]);
+    CHECK(r.size() == 4 && r.try_push_back(&x[0]) == nullptr);
+    r.erase(r.begin(), r.begin() + 2);
+    CHECK(r == (route{&x[2], &x[3]}));
+    CHECK(r.data()[2] == nullptr && r.data()[3] == nullptr);
+    route s = {&x[0]};
+    r.swap(s);
+    CHECK(r.size() == 1 && s.size() == 2 && s[0] == &x[2]);
+    s.pop_back();
+    s.resize(3, &x[1]);
+    CHECK(s == (route{&x[2], &x[1], &x[1]}));
+    s.assign({&x[3]});
+    CHECK(s.size() == 1 && s.data()[1] == nullptr);
+    s.clear();
+    CHECK(s.empty());
+    static_assert([] {
+      using hops =
+          beman::inplace_vector<hop, 5, beman::iv_layout::sentinel<hop::none>>;
+      hops h = {hop::a, hop::c};
+      h.insert(h.begin(), hop::b);
+      h.erase(h.end() - 1);
+      return h == hops{hop::b, hop::a} && h.data()[2] == hop::none;
+    }());
+  }
+
+  { // over-aligned elements and storage
+    struct alignas(32) lanes {
+      float f[8];
+    };
+    vector<lanes, 3> c;
+    c.push_back(lanes{{1}});
+    c.insert(c.begin(), lanes{{2}});
+    CHECK(reinterpret_cast<std::uintptr_t>(c.data()) % 32 == 0);
+    CHECK(c[0].f[0] == 2 && c[1].f[0] == 1);
+
+    struct alignas(64) padded_string {
+      std::string s;
+    };
+    vector<padded_string, 3> p;
+    p.push_back({"a"});
+    p.insert(p.begin(), {"b"});
+    CHECK(reinterpret_cast<std::uintptr_t>(p.data()) % 64 == 0);
+    CHECK(p[0].s == "b" && p[1].s == "a");
+
+    struct {
+      char c;
+      beman::inplace_vector<float, 16, beman::iv_layout::align<64>> v;
+    } s;
+    s.v.push_back(1.f);
+    CHECK(reinterpret_cast<std::uintptr_t>(s.v.data()) % 64 == 0);
+    beman::inplace_vector<std::string, 4, beman::iv_layout::align<64>> strs = {
+        "x", "y"};
+    CHECK(reinterpret_cast<std::uintptr_t>(strs.data()) % 64 == 0);
+    CHECK(strs[1] == "y");
+  }
+
+  { // trivially copyable, non-trivial elements: run-time and constant
+    // evaluation
+    vector<message, 4> c = {{1, 1.5}, {2, 2.5}};
+    c.insert(c.begin() + 1, message{});
+    CHECK(c == (vector<message, 4>{{1, 1.5}, {-1, 0.0}, {2, 2.5}}));
+    vector<message, 4> d = c;
+    c.erase(c.begin());
+    CHECK(c.size() == 2 && d.size() == 3 && d[0].id == 1);
+    static_assert([] {
+      vector<message, 4> c = {{1, 1.5}};
+      c.emplace_back();
+      c.insert(c.begin(), message{3, 0.5});
+      vector<message, 4> d = c;
+      c.swap(d);
+      return c.size() == 3 && c[0].id == 3 && c[2].id == -1 && c == d;
+    }());
+  }
+
   {
     constexpr vector<int, 5> v;
     static_assert(v.data() != nullptr);
@@ -862,6 +1597,245 @@ int main() {
     }
   }
 
+  { // erase and erase_if
+    std::mt19937 rng(3);
+    for (std::size_t n : {0, 1, 15, 16, 17, 100, 1024}) {
+      vector<std::uint32_t, 1024> u;
+      vector<std::int64_t, 1024> i;
+      vector<float, 1024> f;
+      for (std::size_t k = 0; k < n; ++k) {
+        u.push_back(rng() % 4);
+        i.push_back(static_cast<std::int64_t>(rng() % 4) - 2);
+        f.push_back(static_cast<float>(rng() % 4));
+      }
+      std::vector<std::uint32_t> eu(u.begin(), u.end());
+      std::vector<std::int64_t> ei(i.begin(), i.end());
+      std::vector<float> ef(f.begin(), f.end());
+      CHECK(erase(u, 0u) == std::erase(eu, 0u));
+      CHECK(erase_if(i, [](auto e) { return e < 0; }) ==
+            std::erase_if(ei, [](auto e) { return e < 0; }));
+      CHECK(erase(f, 3.f) == std::erase(ef, 3.f));
+      CHECK(std::ranges::equal(u, eu));
+      CHECK(std::ranges::equal(i, ei));
+      CHECK(std::ranges::equal(f, ef));
+    }
+    vector<std::string, 5> s = {"a", "b", "a", "c", "a"};
+    CHECK(erase(s, "a") == 3);
+    CHECK(s == (vector<std::string, 5>{"b", "c"}));
+    int calls = 0;
+    vector<int, 8> v = {1, 2, 3, 4, 5};
+    CHECK(erase_if(v, [&](int e) { return ++calls, e % 2 == 0; }) == 2);
+    CHECK(calls == 5);
+    CHECK(v == (vector<int, 8>{1, 3, 5}));
+    beman::inplace_vector<hop, 5, beman::iv_layout::sentinel<hop::none>> h = {
+        hop::a, hop::b, hop::a, hop::c};
+    CHECK(erase(h, hop::a) == 2);
+    CHECK(h.size() == 2 && h[0] == hop::b && h[1] == hop::c);
+    static_assert([] {
+      vector<int, 40> c;
+      for (int k = 0; k < 40; ++k)
+        c.push_back(k);
+      return erase_if(c, [](int e) { return e % 3 != 0; }) == 26 &&
+             c.size() == 14 && c.back() == 39;
+    }());
+  }
+
+  { // erase_unordered and erase_indices
+    vector<int, 8> v = {0, 1, 2, 3, 4};
+    auto it = v.erase_unordered(v.begin() + 1);
+    CHECK(*it == 4);
+    CHECK(v == (vector<int, 8>{0, 4, 2, 3}));
+    it = v.erase_unordered(v.end() - 1);
+    CHECK(it == v.end());
+    CHECK(v == (vector<int, 8>{0, 4, 2}));
+
+    vector<std::unique_ptr<int>, 4> p;
+    for (int k = 0; k < 3; ++k)
+      p.push_back(std::make_unique<int>(k));
+    p.erase_unordered(p.begin());
+    CHECK(p.size() == 2 && *p[0] == 2 && *p[1] == 1);
+
+    vector<std::string, 8> s = {"a", "b", "c", "d", "e", "f"};
+    CHECK(s.erase_indices(std::vector<int>{0, 2, 3, 5}) == 4);
+    CHECK(s == (vector<std::string, 8>{"b", "e"}));
+    CHECK(s.erase_indices(std::vector<int>{}) == 0);
+    CHECK(s.size() == 2);
+
+    vector<int, 512> e;
+    for (int k = 0; k < 512; ++k)
+      e.push_back(k);
+    std::vector<std::size_t> dead = {3, 50, 51, 200, 511};
+    CHECK(e.erase_indices(dead) == 5);
+    CHECK(e.size() == 507 && e[3] == 4 && e[49] == 52 && e.back() == 510);
+    for (auto d = dead.rbegin(); d != dead.rend(); ++d)
+      e.erase_unordered(e.begin() + static_cast<std::ptrdiff_t>(*d));
+    CHECK(e.size() == 502);
+
+    static_assert([] {
+      vector<int, 8> c = {1, 2, 3, 4, 5};
+      c.erase_unordered(c.begin());
+      int idx[] = {0, 3};
+      c.erase_indices(idx);
+      return c == vector<int, 8>{2, 3};
+    }());
+  }
+
+  { // append_range, try_append_range and unchecked_append_range
+    vector<int, 5> v = {1, 2};
+    std::vector<int> src = {3, 4, 5, 6, 7};
+    auto rest = v.try_append_range(src);
+    CHECK(v == (vector<int, 5>{1, 2, 3, 4, 5}));
+    CHECK(rest == src.begin() + 3);
+    CHECK(v.try_append_range(src) == src.begin()); // already full
+    static_assert(std::same_as<decltype(v.try_append_range(std::vector<int>{})),
+                               std::ranges::dangling>);
+
+    vector<int, 4> l;
+    std::list<int> in = {1, 2, 3, 4, 5};
+    CHECK(*l.try_append_range(in) == 5);
+    CHECK(l == (vector<int, 4>{1, 2, 3, 4}));
+    std::istringstream words("8 9 10");
+    vector<int, 2> w;
+    w.try_append_range(std::views::istream<int>(words));
+    CHECK(w == (vector<int, 2>{8, 9}));
+
+    vector<int, 5> a = {1};
+    CHECK_THROWS(a.append_range(src), std::bad_alloc);
+    CHECK(a == (vector<int, 5>{1})); // sized: checked up front
+    a.unchecked_append_range(std::span(src).first(4));
+    CHECK(a == (vector<int, 5>{1, 3, 4, 5, 6}));
+
+    vector<std::string, 3> s = {"a"};
+    std::vector<std::string> strs = {"b", "c", "d"};
+    CHECK(s.try_append_range(strs) == strs.begin() + 2);
+    CHECK(s == (vector<std::string, 3>{"a", "b", "c"}));
+
+    beman::inplace_vector<hop, 5, beman::iv_layout::sentinel<hop::none>> h = {
+        hop::a};
+    std::vector<hop> hops = {hop::b, hop::c, hop::a, hop::b, hop::c};
+    CHECK(h.try_append_range(hops) == hops.begin() + 4);
+    CHECK(h.size() == 5 && h[4] == hop::b);
+
+    static_assert([] {
+      vector<int, 4> c = {1};
+      int more[] = {2, 3, 4, 5};
+      auto r = c.try_append_range(more);
+      c.pop_back();
+      c.unchecked_append_range(std::span(more).first(1));
+      return r == more + 3 && c == vector<int, 4>{1, 2, 3, 2};
+    }());
+  }
+
+  { // append_generate and append_transform
+    vector<float, 256> f = {-1.f};
+    f.append_generate(
+        100, [](std::size_t i) { return 0.5f * static_cast<float>(i); });
+    CHECK(f.size() == 101 && f[0] == -1.f && f[1] == 0.f && f[100] == 49.5f);
+    int next = 0;
+    f.append_generate(3, [&] { return static_cast<float>(next++); });
+    CHECK(f.size() == 104 && f[103] == 2.f && next == 3);
+    CHECK_THROWS(f.append_generate(153, [] { return 0.f; }), std::bad_alloc);
+    CHECK(f.size() == 104);
+
+    std::vector<float> in = {1.f, 2.f, 3.f};
+    vector<float, 4> t;
+    t.append_transform(in, [](float x) { return x * 2.f + 1.f; });
+    CHECK(t == (vector<float, 4>{3.f, 5.f, 7.f}));
+    CHECK_THROWS(t.append_transform(in, [](float x) { return x; }),
+                 std::bad_alloc);
+    CHECK(t.size() == 3);
+
+    struct particle {
+      float x, v;
+    };
+    std::list<particle> ps = {{1.f, 2.f}, {3.f, 4.f}};
+    vector<float, 4> xs;
+    xs.append_transform(ps, &particle::x);
+    CHECK(xs == (vector<float, 4>{1.f, 3.f}));
+    std::istringstream words("ab cde");
+    vector<std::size_t, 2> lens;
+    lens.append_transform(std::views::istream<std::string>(words),
+                          [](const std::string &w) { return w.size(); });
+    CHECK(lens == (vector<std::size_t, 2>{2, 3}));
+    vector<std::string, 3> strs;
+    strs.append_generate(
+        2, [](std::size_t i) { return std::string(i + 1, 'x'); });
+    CHECK(strs == (vector<std::string, 3>{"x", "xx"}));
+
+    static_assert([] {
+      vector<int, 8> c;
+      c.append_generate(
+          3, [](std::size_t i) { return static_cast<int>(i * i); });
+      int more[] = {5, 6};
+      c.append_transform(more, [](int x) { return -x; });
+      return c == vector<int, 8>{0, 1, 4, -5, -6};
+    }());
+  }
+
+  { // push_back_if and append_if
+    vector<std::uint32_t, 4> v;
+    for (std::uint32_t k = 0; k < 6; ++k)
+      v.push_back_if(k % 2 == 1, k);
+    CHECK(v == (vector<std::uint32_t, 4>{1, 3, 5}));
+    v.push_back_if(true, 7);
+    v.push_back_if(false, 9); // full, but nothing to append
+    CHECK(v.size() == 4);
+    CHECK_THROWS(v.push_back_if(true, 9), std::bad_alloc);
+
+    std::mt19937 rng(5);
+    auto odd = [](std::uint32_t e) { return e % 2 == 1; };
+    for (std::size_t n : {0, 1, 7, 8, 9, 16, 17, 100, 256}) {
+      std::vector<std::uint32_t> in(n);
+      for (auto &e : in)
+        e = rng() % 10;
+      std::vector<std::uint32_t> expected = {42};
+      std::copy_if(in.begin(), in.end(), std::back_inserter(expected), odd);
+      vector<std::uint32_t, 256> out = {42};
+      out.append_if(in, odd);
+      CHECK(std::ranges::equal(out, expected));
+    }
+    // The free slots are fewer than the input, but enough for what passes.
+    vector<std::uint32_t, 8> small = {0, 0, 0, 0, 0};
+    small.append_if(std::vector<std::uint32_t>{1, 2, 3, 4, 6, 8, 5}, odd);
+    CHECK(small == (vector<std::uint32_t, 8>{0, 0, 0, 0, 0, 1, 3, 5}));
+    CHECK_THROWS(small.append_if(std::vector<std::uint32_t>{2, 7}, odd),
+                 std::bad_alloc);
+
+    // Layouts that fix the value of the slots past size().
+    beman::inplace_vector<int, 12, beman::iv_layout::pad_to<64>> padded;
+    padded.push_back_if(false, 5);
+    padded.append_if(std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9},
+                     [](int e) { return e > 6; });
+    CHECK(padded.size() == 3 && padded.sum() == 24);
+    CHECK(std::all_of(padded.data() + padded.size(),
+                      padded.data() + padded.padded_capacity(),
+                      [](int e) { return e == 0; }));
+    beman::inplace_vector<hop, 5, beman::iv_layout::sentinel<hop::none>> h;
+    h.push_back_if(false, hop::a);
+    h.push_back_if(true, hop::b);
+    h.append_if(std::vector<hop>{hop::a, hop::c, hop::a},
+                [](hop e) { return e != hop::a; });
+    CHECK(h.size() == 2 && h[0] == hop::b && h[1] == hop::c);
+
+    // Non-contiguous and non-trivial ranges.
+    vector<int, 4> l;
+    l.append_if(std::list<int>{1, 2, 3, 4}, [](int e) { return e > 2; });
+    CHECK(l == (vector<int, 4>{3, 4}));
+    vector<std::string, 4> s;
+    s.append_if(std::vector<std::string>{"a", "bb", "c"},
+                [](auto &e) { return e.size() == 1; });
+    CHECK(s == (vector<std::string, 4>{"a", "c"}));
+
+    static_assert([] {
+      vector<int, 8> c;
+      int in[] = {1, 2, 3, 4, 5};
+      c.append_if(in, [](int e) { return e % 2 == 0; });
+      c.push_back_if(false, 7);
+      c.push_back_if(true, 8);
+      return c == vector<int, 8>{2, 4, 8};
+    }());
+  }
+
   { // insert init list
     {
       vector<int, 15> d(10, 1);
@@ -1047,6 +2021,95 @@ int main() {
     }
   }
 
+  { // trivially relocatable elements
+    using vec_t = vector<relocatable, 8>;
+    auto values = [](vec_t const &v) {
+      std::vector<int> r;
+      for (auto const &e : v)
+        r.push_back(e.value());
+      return r;
+    };
+    vec_t v;
+    for (int i = 0; i != 5; ++i)
+      v.emplace_back(i);
+    v.erase(v.begin() + 1, v.begin() + 3);
+    CHECK(values(v) == std::vector<int>{0, 3, 4});
+    v.emplace(v.begin() + 1, 7);
+    v.insert(v.begin(), relocatable(9));
+    CHECK(values(v) == std::vector<int>{9, 0, 7, 3, 4});
+    int const bad[] = {5, -1};
+    CHECK_THROWS(v.insert(v.begin() + 2, std::begin(bad), std::end(bad)),
+                 std::invalid_argument);
+    CHECK(values(v) == std::vector<int>{9, 0, 7, 3, 4}); // rolled back
+    vec_t w(std::move(v));
+    CHECK(v.empty()); // relocated away
+    CHECK(values(w) == std::vector<int>{9, 0, 7, 3, 4});
+    v.emplace_back(1);
+    v = std::move(w);
+    CHECK(w.empty());
+    CHECK(values(v) == std::vector<int>{9, 0, 7, 3, 4});
+    v.swap(w);
+    CHECK(v.empty());
+    CHECK(values(w) == std::vector<int>{9, 0, 7, 3, 4});
+  }
+
+  { // insert into the middle during constant evaluation
+    static_assert([] {
+      vector<int, 8> v = {1, 5};
+      v.insert(v.cbegin() + 1, {2, 3});
+      v.insert(v.cbegin() + 3, 1, 4);
+      v.emplace(v.cbegin(), 0);
+      return v == vector<int, 8>{0, 1, 2, 3, 4, 5};
+    }());
+  }
+
+  { // insert into the middle of non-trivial elements
+    using S = std::string;
+    using vec_t = vector<S, 10>;
+    auto make = [] { return vec_t{"a", "b", "c", "d", "e"}; };
+    {
+      vec_t v = make(); // tail longer than the insertion
+      S in[] = {"x", "y"};
+      auto i = v.insert(v.cbegin() + 1, std::begin(in), std::end(in));
+      CHECK(i == v.begin() + 1);
+      CHECK(v == vec_t{"a", "x", "y", "b", "c", "d", "e"});
+      CHECK(in[0] == "x"); // inserted by copy
+    }
+    {
+      vec_t v = make(); // tail shorter than the insertion
+      auto i = v.insert(v.cbegin() + 4, {"x", "y", "z"});
+      CHECK(i == v.begin() + 4);
+      CHECK(v == vec_t{"a", "b", "c", "d", "x", "y", "z", "e"});
+    }
+    {
+      vec_t v = make(); // repeated value aliasing an element
+      auto i = v.insert(v.cbegin(), 3, v[4]);
+      CHECK(i == v.begin());
+      CHECK(v == vec_t{"e", "e", "e", "a", "b", "c", "d", "e"});
+    }
+    {
+      vec_t v = make(); // emplace aliasing an element
+      auto i = v.emplace(v.cbegin() + 2, v.back());
+      CHECK(i == v.begin() + 2);
+      CHECK(v == vec_t{"a", "b", "e", "c", "d", "e"});
+    }
+    {
+      vec_t v = make(); // bidirectional iterators
+      std::list<S> l = {"x", "y", "z"};
+      v.insert(v.cbegin() + 2, l.begin(), l.end());
+      CHECK(v == vec_t{"a", "b", "x", "y", "z", "c", "d", "e"});
+      CHECK_THROWS(v.insert(v.cbegin(), l.begin(), l.end()), std::bad_alloc);
+      CHECK(v.size() == 8);
+    }
+    {
+      vector<int, 10> v = {1, 2, 3}; // single-pass input iterators
+      std::istringstream in("7 8 9");
+      v.insert(v.cbegin() + 1, std::istream_iterator<int>(in),
+               std::istream_iterator<int>());
+      CHECK(v == vector<int, 10>{1, 7, 8, 9, 2, 3});
+    }
+  }
+
   { // push back move only
     {
       vector<moint, 6> c;